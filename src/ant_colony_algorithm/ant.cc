@@ -26,7 +26,7 @@ Ant::Ant(const Graph& graph, size_t starting_vetrex)
 }
 
 void Ant::RunAnt(const Matrix& probabilities) {
-  probabilities_ = probabilities;
+  probabilities_ = &probabilities;
 
   SetDefaultData();
 
@@ -64,8 +64,9 @@ size_t Ant::ChooseVertex() {
 double Ant::CalculateVariants() {
   variants_.clear();
   double sum = 0.0;
+  Matrix::ConstRow probabilities = (*probabilities_)[current_vertex_];
   for (const auto& next_vertex : unvisited_vertices_) {
-    double value = probabilities_(current_vertex_, next_vertex);
+    double value = probabilities[next_vertex];
     variants_.insert({next_vertex, value});
     sum += value;
   }
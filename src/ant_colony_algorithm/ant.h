@@ -29,7 +29,8 @@ class Ant {
   void SetDefaultData();
 
   Graph graph_;
-  Matrix probabilities_;
+  // borrowed for the duration of RunAnt
+  const Matrix *probabilities_{nullptr};
 
   size_t size_;
   size_t starting_vertex_;
@@ -3,7 +3,9 @@
 #include <algorithm>
 #include <cmath>
 #include <execution>
+#include <limits>
 #include <map>
+#include <stdexcept>
 #include <vector>
 
 #include "../s21_graph.h"
@@ -11,8 +13,27 @@
 
 using namespace s21;
 
-AntColonyAlgorithm::AntColonyAlgorithm(const Graph& graph)
-    : graph_(graph),
+size_t AntColonyAlgorithm::GetMemoryBytes(size_t size) {
+  // four matrices of doubles and one ant per vertex
+  const size_t pair_bytes = 4 * sizeof(double) + kAntBytesPerVertex;
+  const size_t stride = Matrix::GetStride(size);
+  if (stride != 0 &&
+      stride > std::numeric_limits<size_t>::max() / pair_bytes / size) {
+    return std::numeric_limits<size_t>::max();
+  }
+  return size * stride * pair_bytes;
+}
+
+const Graph& AntColonyAlgorithm::CheckMemoryLimit(const Graph& graph) {
+  if (GetMemoryBytes(graph.size()) > graph.GetMemoryLimit()) {
+    throw std::invalid_argument(
+        "The ant colony matrices exceed the memory limit.");
+  }
+  return graph;
+}
+
+AntColonyAlgorithm::AntColonyAlgorithm(const Graph& graph, bool local_search)
+    : graph_(CheckMemoryLimit(graph)),
       size_(graph.size()),
       ants_number_(graph.size()),
       closeness_(graph.size()),
@@ -29,21 +50,20 @@ AntColonyAlgorithm::AntColonyAlgorithm(const Graph& graph)
   best_solution_ = {std::numeric_limits<double>::infinity(), {}};
   break_limit_ = size_;
   break_count_ = 0;
+  if (local_search) local_search_.emplace(graph_);
 }
 
 void AntColonyAlgorithm::InitializeMatrices() {
   double sum_of_all_distances = 0.0;
   for (size_t i = 0; i < size_; ++i) {
-    for (size_t j = 0; j < size_; ++j) {
-      size_t edge = graph_.GetEdge(i, j);
-      if (edge) {
-        closeness_(i, j) = powl(1.0 / edge, kClosenessImpact);
-        pheromones_(i, j) = kInitialPheromoneValue;
-        probabilities_(i, j) =
-            powl(pheromones_(i, j), kPheromonesImpact) * closeness_(i, j);
-        sum_of_all_distances += edge;
-      }
-    }
+    graph_.ForEachNeighbour(i, [&](const Graph::Neighbour& neighbour) {
+      size_t j = neighbour.vertex;
+      closeness_(i, j) = powl(1.0 / neighbour.weight, kClosenessImpact);
+      pheromones_(i, j) = kInitialPheromoneValue;
+      probabilities_(i, j) =
+          powl(pheromones_(i, j), kPheromonesImpact) * closeness_(i, j);
+      sum_of_all_distances += neighbour.weight;
+    });
   }
   average_distance_ = sum_of_all_distances / (size_);
 }
@@ -85,19 +105,31 @@ void AntColonyAlgorithm::LaunchAnts() {
 }
 
 void AntColonyAlgorithm::GetPaths() {
-  std::for_each(
-      std::execution::seq, ants_.begin(), ants_.end(), [&](const Ant& ant) {
-        solutions_.insert({ant.GetSolution().distance, ant.GetSolution()});
-
-        if (ant.GetSolution().distance < best_solution_.distance) {
-          best_solution_ = ant.GetSolution();
-          elite_pheromones_ = CreatePheromones(
-              best_solution_.path,
-              ((average_distance_ * static_cast<double>(elite_ants_number_)) /
-               best_solution_.distance));
-          break_count_ = 0;
-        }
-      });
+  for (const Ant& ant : ants_) {
+    solutions_.insert({ant.GetSolution().distance, ant.GetSolution()});
+  }
+  if (local_search_) ImproveIterationBest();
+
+  const Ant::Solution& iteration_best = solutions_.begin()->second;
+  if (iteration_best.distance < best_solution_.distance) {
+    best_solution_ = iteration_best;
+    elite_pheromones_ = CreatePheromones(
+        best_solution_.path,
+        ((average_distance_ * static_cast<double>(elite_ants_number_)) /
+         best_solution_.distance));
+    break_count_ = 0;
+  }
+}
+
+void AntColonyAlgorithm::ImproveIterationBest() {
+  auto node = solutions_.extract(solutions_.begin());
+  Ant::Solution& solution = node.mapped();
+  size_t length = local_search_->Improve(solution.path);
+  solution.distance = length == LocalSearch::kInfinity
+                          ? std::numeric_limits<double>::infinity()
+                          : static_cast<double>(length);
+  node.key() = solution.distance;
+  solutions_.insert(std::move(node));
 }
 
 Matrix AntColonyAlgorithm::CreatePheromones(std::vector<size_t> path,
@@ -130,12 +162,15 @@ void AntColonyAlgorithm::UpdatePheromones() {
 }
 
 void AntColonyAlgorithm::UpdateProbabilities() {
+  // closeness_ is non-zero exactly on the edges
   for (size_t i = 0; i < size_; ++i) {
+    const double* closeness = closeness_[i].data();
+    const double* pheromones = pheromones_[i].data();
+    double* probabilities = probabilities_[i].data();
     for (size_t j = 0; j < size_; ++j) {
-      size_t edge = graph_.GetEdge(i, j);
-      if (edge) {
-        probabilities_(i, j) =
-            powl(pheromones_(i, j), kPheromonesImpact) * closeness_(i, j);
+      if (closeness[j] != 0.0) {
+        probabilities[j] =
+            std::pow(pheromones[j], kPheromonesImpact) * closeness[j];
       }
     }
   }
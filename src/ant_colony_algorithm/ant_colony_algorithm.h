@@ -2,10 +2,12 @@
 #define NAVIGATOR_ANT_COLONY_ALGORITHM_ANT_COLONY_ALGORITHM_H_
 
 #include <map>
+#include <optional>
 #include <set>
 #include <vector>
 
 #include "../s21_graph.h"
+#include "../tsp/local_search.h"
 #include "ant.h"
 
 using namespace s21;
@@ -14,15 +16,25 @@ class AntColonyAlgorithm {
  public:
   using ResultTSP = std::pair<std::vector<size_t>, double>;
 
-  explicit AntColonyAlgorithm(const Graph &graph);
+  // pheromone, closeness and probability matrices plus the per-vertex state
+  // of every ant; the colony keeps them for all vertex pairs even when the
+  // graph computes its edges
+  static size_t GetMemoryBytes(size_t size);
+
+  // local_search improves the best ant of every iteration before it lays
+  // pheromones. Throws std::invalid_argument if GetMemoryBytes exceeds the
+  // graph memory limit.
+  explicit AntColonyAlgorithm(const Graph &graph, bool local_search = false);
   void RunAlgorithm();
   ResultTSP GetResult() const;
 
  private:
+  static const Graph &CheckMemoryLimit(const Graph &graph);
   void InitializeMatrices();
   void InitializeAnts();
   void LaunchAnts();
   void GetPaths();
+  void ImproveIterationBest();
   Matrix CreatePheromones(std::vector<size_t> path, double value);
   void UpdatePheromones();
   void UpdateProbabilities();
@@ -50,8 +62,11 @@ class AntColonyAlgorithm {
   static constexpr double kVaporization = 0.5;
   static constexpr double kPheromonesImpact = 1;
   static constexpr double kClosenessImpact = 5;
+  // unvisited set node and path entry of one vertex in one ant
+  static const size_t kAntBytesPerVertex = 64;
 
   Ant::Solution best_solution_;
+  std::optional<LocalSearch> local_search_;
 };
 
 #endif  // NAVIGATOR_ANT_COLONY_ALGORITHM_ANT_COLONY_ALGORITHM_H_
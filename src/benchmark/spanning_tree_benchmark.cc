@@ -0,0 +1,65 @@
+// Minimum spanning tree strategies on a random connected sparse graph:
+//   spanning_tree_benchmark [vertices] [edges] [threads]
+// Prints the time and weight of each strategy; the weights must agree.
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <string>
+
+#include "parallel_for.h"
+#include "s21_graph_algorithms.h"
+
+namespace {
+
+const char *kTempFile = "temp_benchmark.edges";
+
+// a random path through all vertices keeps the graph connected
+void WriteRandomGraph(size_t vertices, size_t edges) {
+  std::mt19937_64 generator(1);
+  std::uniform_int_distribution<size_t> vertex(1, vertices);
+  std::uniform_int_distribution<size_t> weight(1, 1000000);
+  std::ofstream file(kTempFile);
+  auto write_edge = [&file](size_t from, size_t to, size_t w) {
+    file << from << ' ' << to << ' ' << w << '\n'
+         << to << ' ' << from << ' ' << w << '\n';
+  };
+  for (size_t v = 1; v < vertices; ++v) write_edge(v, v + 1, weight(generator));
+  for (size_t i = 0; i < edges; ++i) {
+    size_t from = vertex(generator);
+    size_t to = vertex(generator);
+    if (from != to) write_edge(from, to, weight(generator));
+  }
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+  using Strategy = s21::GraphAlgorithms::SpanningTreeStrategy;
+  size_t vertices = argc > 1 ? std::stoul(argv[1]) : 1000000;
+  size_t edges = argc > 2 ? std::stoul(argv[2]) : 4 * vertices;
+  size_t num_threads = argc > 3 ? std::stoul(argv[3]) : 0;
+  WriteRandomGraph(vertices, edges);
+  s21::Graph graph;
+  graph.LoadGraphFromFile(kTempFile, s21::Graph::Representation::kSparse);
+  std::remove(kTempFile);
+  std::cout << "vertices " << graph.size() << ", arcs " << graph.GetNumEdges()
+            << ", threads " << s21::GetNumThreads(num_threads) << std::endl;
+  const std::pair<Strategy, const char *> strategies[] = {
+      {Strategy::kPrim, "prim"},
+      {Strategy::kKruskal, "kruskal"},
+      {Strategy::kBoruvka, "boruvka"}};
+  for (const auto &[strategy, name] : strategies) {
+    auto start = std::chrono::steady_clock::now();
+    s21::GraphAlgorithms::SpanningTreeResult tree =
+        s21::GraphAlgorithms::GetMinimumSpanningTree(graph, strategy,
+                                                     num_threads);
+    std::chrono::duration<double> time =
+        std::chrono::steady_clock::now() - start;
+    std::cout << name << ": " << time.count() << " s, weight " << tree.weight
+              << std::endl;
+  }
+  return 0;
+}
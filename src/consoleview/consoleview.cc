@@ -27,7 +27,10 @@ ConsoleView::ConsoleView(Controller* c)
           {9,
            {"Compare Travelling Salesman Problem solving methods",
             &ConsoleView::TSPComare}},
-          {10, {"Exit", &ConsoleView::ExitAction}}} {};
+          {10,
+           {"Convert graph to binary file .bin",
+            &ConsoleView::ExportGraphBinary}},
+          {11, {"Exit", &ConsoleView::ExitAction}}} {};
 
 void ConsoleView::StartEventLoop() {
   while (!event_loop_end_) {
@@ -52,7 +55,8 @@ void ConsoleView::BreadthFirstSearch() {
   }
   std::string prompt = "Input a Vertex number to start search (" +
                        std::to_string(GraphAlgorithms::kVertexStartNumber) +
-                       "-" + std::to_string(Graph::kMaxSize) + "): ";
+                       "-" + std::to_string(controller_->GetModelSize()) +
+                       "): ";
   data_.point_a = PerformNumericInput(prompt);
   controller_->BreadthFirstSearch(&data_);
   PrintArray(controller_->array_result());
@@ -66,7 +70,8 @@ void ConsoleView::DepthFirstSearch() {
   }
   std::string prompt = "Input a Vertex number to start search (" +
                        std::to_string(GraphAlgorithms::kVertexStartNumber) +
-                       "-" + std::to_string(Graph::kMaxSize) + "): ";
+                       "-" + std::to_string(controller_->GetModelSize()) +
+                       "): ";
   data_.point_a = PerformNumericInput(prompt);
   controller_->DepthFirstSearch(&data_);
   PrintArray(controller_->array_result());
@@ -92,6 +97,18 @@ void ConsoleView::ExportGraph() {
   FinalMessage(message);
 }
 
+void ConsoleView::ExportGraphBinary() {
+  if (!controller_->IsModelLoaded()) {
+    ErrorMessage("Model is not loaded");
+    return;
+  }
+  PerformStringInput();
+  controller_->ExportGraphToBinary(&data_);
+  std::string message =
+      "Graph successfully converted to file " + data_.filename + ".bin";
+  FinalMessage(message);
+}
+
 void ConsoleView::LeastSpanningTree() {
   if (!controller_->IsModelLoaded()) {
     ErrorMessage("Model is not loaded");
@@ -100,6 +117,7 @@ void ConsoleView::LeastSpanningTree() {
   controller_->GetLeastSpanningTree();
   Graph::AdjacencyMatrix result_matrix = controller_->adjacency_matrix_result();
   PrintMatrix(result_matrix);
+  PrintValue(controller_->value_result(), "Connected components: ");
   FinalMessage("LeastSpanningTree finished");
 }
 
@@ -149,14 +167,16 @@ void ConsoleView::ShortestPathBetweenVertices() {
   std::string prompt_start =
       "Input a START Vertex number(" +
       std::to_string(GraphAlgorithms::kVertexStartNumber) + "-" +
-      std::to_string(Graph::kMaxSize) + "): ";
-  std::string prompt_end = "Input a END Vertex number (" +
-                           std::to_string(GraphAlgorithms::kVertexStartNumber) +
-                           "-" + std::to_string(Graph::kMaxSize) + "): ";
+      std::to_string(controller_->GetModelSize()) + "): ";
+  std::string prompt_end =
+      "Input a END Vertex number (" +
+      std::to_string(GraphAlgorithms::kVertexStartNumber) + "-" +
+      std::to_string(controller_->GetModelSize()) + "): ";
   data_.point_a = PerformNumericInput(prompt_start);
   data_.point_b = PerformNumericInput(prompt_end);
 
   controller_->GetShortestPathBetweenVertices(&data_);
+  PrintArray(controller_->array_result());
   PrintValue(controller_->value_result());
   FinalMessage("ShortestPathBetweenVertices finished");
 }
@@ -225,9 +245,9 @@ void ConsoleView::PrintArray(const GraphAlgorithms::ResultArray& array) {
 
 void ConsoleView::PrintMatrix(const Graph::AdjacencyMatrix& matrix) {
   std::cout << "Result matrix : " << std::endl;
-  for (size_t i = 0; i < matrix.size(); i++) {
-    for (size_t j = 0; j < matrix.at(i).size(); j++) {
-      std::cout << std::setw(5) << matrix[i][j] << " ";
+  for (size_t i = 0; i < matrix.GetRows(); i++) {
+    for (size_t j = 0; j < matrix.GetCols(); j++) {
+      std::cout << std::setw(5) << matrix(i, j) << " ";
     }
     std::cout << std::endl;
   }
@@ -24,6 +24,7 @@ class ConsoleView {
   void DisplayMenu();
   void ExitAction();
   void ExportGraph();
+  void ExportGraphBinary();
   void LeastSpanningTree();
   void LoadGraph();
   int PerformChoice();
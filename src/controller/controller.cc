@@ -16,13 +16,23 @@ void Controller::ExportGraphToDot(const GraphAppData *data) {
   model_->ExportGraphToDot(data->filename);
 }
 
+void Controller::ExportGraphToBinary(const GraphAppData *data) {
+  model_->ExportGraphToBinary(data->filename);
+}
+
 void Controller::GetLeastSpanningTree() {
-  adjacency_matrix_result_ = GraphAlgorithms::GetLeastSpanningTree(*model_);
+  GraphAlgorithms::SpanningTreeResult tree =
+      GraphAlgorithms::GetMinimumSpanningTree(*model_);
+  adjacency_matrix_result_ =
+      GraphAlgorithms::GetLeastSpanningTree(model_->size(), tree);
+  value_result_ = tree.num_components;
 }
 
 void Controller::GetShortestPathBetweenVertices(const GraphAppData *data) {
-  value_result_ = GraphAlgorithms::GetShortestPathBetweenVertices(
+  GraphAlgorithms::PathResult result = GraphAlgorithms::GetShortestPath(
       *model_, data->point_a, data->point_b);
+  value_result_ = result.distance;
+  array_result_ = result.vertices;
 }
 
 void Controller::GetShortestPathsBetweenAllVertices() {
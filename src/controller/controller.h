@@ -17,7 +17,14 @@ struct GraphAppData {
 
 class Controller {
  public:
-  explicit Controller(Graph *m) : model_(m){};
+  // shortest-path trees kept for repeated queries from the same vertex
+  static const size_t kShortestPathCacheBytes = size_t{64} << 20;
+
+  explicit Controller(Graph *m) : model_(m) {
+    if (model_ != nullptr) {
+      model_->SetShortestPathCache(kShortestPathCacheBytes);
+    }
+  };
 
   const std::chrono::milliseconds &time_result(int i) const {
     return time_result_[i];
@@ -33,6 +40,7 @@ class Controller {
   void BreadthFirstSearch(const GraphAppData *data);
   void DepthFirstSearch(const GraphAppData *data);
   void ExportGraphToDot(const GraphAppData *data);
+  void ExportGraphToBinary(const GraphAppData *data);
   void GetLeastSpanningTree();
   void GetShortestPathBetweenVertices(const GraphAppData *data);
   void GetShortestPathsBetweenAllVertices();
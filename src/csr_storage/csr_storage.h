@@ -0,0 +1,238 @@
+#ifndef NAVIGATOR_CSR_STORAGE_CSR_STORAGE_H_
+#define NAVIGATOR_CSR_STORAGE_CSR_STORAGE_H_
+
+#include <algorithm>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include "matrix.h"
+
+namespace s21 {
+
+/** CsrStorage
+ *! @brief Adjacency lists in compressed sparse row form: the neighbours of
+ *! vertex v are vertices/weights in [offsets[v], offsets[v + 1]), sorted by
+ *! vertex number. Zero weights are not stored (no edge).
+ *! The arrays are either owned or borrowed from a memory-mapped file, so the
+ *! storage is immutable and not copyable; share it through shared_ptr.
+ */
+class CsrStorage {
+ public:
+  struct Neighbour {
+    size_t vertex;
+    size_t weight;
+  };
+
+  struct Edge {
+    size_t from;
+    size_t to;
+    size_t weight;
+  };
+
+  class NeighbourIterator {
+   public:
+    NeighbourIterator(const size_t *vertex, const size_t *weight)
+        : vertex_(vertex), weight_(weight) {}
+
+    Neighbour operator*() const { return {*vertex_, *weight_}; }
+    NeighbourIterator &operator++() {
+      ++vertex_;
+      ++weight_;
+      return *this;
+    }
+    bool operator==(const NeighbourIterator &other) const {
+      return vertex_ == other.vertex_;
+    }
+    bool operator!=(const NeighbourIterator &other) const {
+      return vertex_ != other.vertex_;
+    }
+
+   private:
+    const size_t *vertex_;
+    const size_t *weight_;
+  };
+
+  class NeighbourRange {
+   public:
+    NeighbourRange(const size_t *vertices, const size_t *weights, size_t size)
+        : vertices_(vertices), weights_(weights), size_(size) {}
+
+    NeighbourIterator begin() const { return {vertices_, weights_}; }
+    NeighbourIterator end() const {
+      return {vertices_ + size_, weights_ + size_};
+    }
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    Neighbour operator[](size_t index) const {
+      return {vertices_[index], weights_[index]};
+    }
+
+   private:
+    const size_t *vertices_;
+    const size_t *weights_;
+    size_t size_;
+  };
+
+  // Rows are built in order: AddEdge() for every column of the current row
+  // in ascending order, then FinishRow().
+  class Builder {
+   public:
+    Builder() : offsets_(1, 0) {}
+
+    void Reserve(size_t vertices, size_t edges) {
+      offsets_.reserve(vertices + 1);
+      vertices_.reserve(edges);
+      weights_.reserve(edges);
+    }
+    void AddEdge(size_t to, size_t weight) {
+      if (weight == 0) return;
+      vertices_.push_back(to);
+      weights_.push_back(weight);
+    }
+    void FinishRow() { offsets_.push_back(vertices_.size()); }
+    size_t GetNumEdges() const { return vertices_.size(); }
+
+    std::shared_ptr<const CsrStorage> Build() {
+      return std::make_shared<const CsrStorage>(
+          std::move(offsets_), std::move(vertices_), std::move(weights_));
+    }
+
+   private:
+    friend class CsrStorage;
+
+    std::vector<size_t> offsets_;
+    std::vector<size_t> vertices_;
+    std::vector<size_t> weights_;
+  };
+
+  CsrStorage() : CsrStorage(std::vector<size_t>(1, 0), {}, {}) {}
+
+  explicit CsrStorage(const BasicMatrix<size_t> &matrix)
+      : CsrStorage(FromMatrix(matrix)) {}
+
+  CsrStorage(std::vector<size_t> offsets, std::vector<size_t> vertices,
+             std::vector<size_t> weights)
+      : owned_offsets_(std::move(offsets)),
+        owned_vertices_(std::move(vertices)),
+        owned_weights_(std::move(weights)),
+        offsets_(owned_offsets_.data()),
+        vertices_(owned_vertices_.data()),
+        weights_(owned_weights_.data()),
+        num_vertices_(owned_offsets_.size() - 1) {}
+
+  // Borrows the arrays; owner keeps the underlying memory alive.
+  CsrStorage(std::shared_ptr<const void> owner, const size_t *offsets,
+             const size_t *vertices, const size_t *weights,
+             size_t num_vertices)
+      : owner_(std::move(owner)),
+        offsets_(offsets),
+        vertices_(vertices),
+        weights_(weights),
+        num_vertices_(num_vertices) {}
+
+  // Arcs in any order; parallel arcs keep the lightest weight.
+  static std::shared_ptr<const CsrStorage> FromEdges(size_t vertices,
+                                                     std::vector<Edge> edges) {
+    std::sort(edges.begin(), edges.end(), [](const Edge &a, const Edge &b) {
+      if (a.from != b.from) return a.from < b.from;
+      if (a.to != b.to) return a.to < b.to;
+      return a.weight < b.weight;
+    });
+    Builder builder;
+    builder.Reserve(vertices, edges.size());
+    size_t next = 0;
+    for (size_t from = 0; from < vertices; ++from) {
+      for (; next < edges.size() && edges[next].from == from; ++next) {
+        const Edge &edge = edges[next];
+        bool parallel = next > 0 && edges[next - 1].from == from &&
+                        edges[next - 1].to == edge.to;
+        if (!parallel) builder.AddEdge(edge.to, edge.weight);
+      }
+      builder.FinishRow();
+    }
+    if (next != edges.size()) throw std::out_of_range("Vertex out of range");
+    return builder.Build();
+  }
+
+  // Lists of incoming edges: u appears among the neighbours of v in the
+  // result for every edge u -> v, in O(V + E) by counting sort.
+  std::shared_ptr<const CsrStorage> Transpose() const {
+    std::vector<size_t> offsets(num_vertices_ + 1, 0);
+    for (size_t i = 0; i < GetNumEdges(); ++i) ++offsets[vertices_[i] + 1];
+    for (size_t v = 0; v < num_vertices_; ++v) offsets[v + 1] += offsets[v];
+    std::vector<size_t> next(offsets.begin(), offsets.end() - 1);
+    std::vector<size_t> vertices(GetNumEdges());
+    std::vector<size_t> weights(GetNumEdges());
+    // sources are visited in ascending order, so the rows come out sorted
+    for (size_t from = 0; from < num_vertices_; ++from) {
+      for (size_t i = offsets_[from]; i < offsets_[from + 1]; ++i) {
+        size_t position = next[vertices_[i]]++;
+        vertices[position] = from;
+        weights[position] = weights_[i];
+      }
+    }
+    return std::make_shared<const CsrStorage>(
+        std::move(offsets), std::move(vertices), std::move(weights));
+  }
+
+  CsrStorage(const CsrStorage &) = delete;
+  CsrStorage &operator=(const CsrStorage &) = delete;
+
+  size_t GetNumVertices() const { return num_vertices_; }
+  size_t GetNumEdges() const { return offsets_[num_vertices_]; }
+  const size_t *GetOffsets() const { return offsets_; }
+  const size_t *GetVertices() const { return vertices_; }
+  const size_t *GetWeights() const { return weights_; }
+
+  NeighbourRange GetNeighbours(size_t vertex) const {
+    if (vertex >= num_vertices_) throw std::out_of_range("Vertex out of range");
+    size_t first = offsets_[vertex];
+    return {vertices_ + first, weights_ + first, offsets_[vertex + 1] - first};
+  }
+  // same interface as Graph::ForEachNeighbour
+  template <typename Function>
+  void ForEachNeighbour(size_t vertex, Function function) const {
+    for (const auto &neighbour : GetNeighbours(vertex)) function(neighbour);
+  }
+
+  size_t GetEdge(size_t from, size_t to) const {
+    if (to >= num_vertices_) throw std::out_of_range("Vertex out of range");
+    NeighbourRange neighbours = GetNeighbours(from);
+    const size_t *first = vertices_ + offsets_[from];
+    const size_t *last = first + neighbours.size();
+    const size_t *it = std::lower_bound(first, last, to);
+    if (it == last || *it != to) return 0;
+    return weights_[it - vertices_];
+  }
+
+ private:
+  static Builder FromMatrix(const BasicMatrix<size_t> &matrix) {
+    Builder builder;
+    builder.Reserve(matrix.GetRows(), 0);
+    for (size_t from = 0; from < matrix.GetRows(); ++from) {
+      BasicMatrix<size_t>::ConstRow row = matrix[from];
+      for (size_t to = 0; to < row.size(); ++to) {
+        builder.AddEdge(to, row[to]);
+      }
+      builder.FinishRow();
+    }
+    return builder;
+  }
+  explicit CsrStorage(Builder &&builder)
+      : CsrStorage(std::move(builder.offsets_), std::move(builder.vertices_),
+                   std::move(builder.weights_)) {}
+
+  std::shared_ptr<const void> owner_;
+  std::vector<size_t> owned_offsets_;
+  std::vector<size_t> owned_vertices_;
+  std::vector<size_t> owned_weights_;
+  const size_t *offsets_;
+  const size_t *vertices_;
+  const size_t *weights_;
+  size_t num_vertices_;
+};
+
+}  // namespace s21
+
+#endif  // NAVIGATOR_CSR_STORAGE_CSR_STORAGE_H_
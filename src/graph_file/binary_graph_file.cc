@@ -0,0 +1,122 @@
+#include "binary_graph_file.h"
+
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <vector>
+
+#include "mapped_file.h"
+
+namespace s21 {
+
+static_assert(sizeof(BinaryGraphFile::Header) == BinaryGraphFile::kAlignment,
+              "Header must fill exactly one aligned block");
+static_assert(sizeof(size_t) == sizeof(uint64_t),
+              "Mapped arrays are used as size_t directly");
+
+bool BinaryGraphFile::IsBinaryGraphFile(const std::string &filename) {
+  std::ifstream file(filename, std::ios::binary);
+  char magic[sizeof(kMagic)] = {};
+  file.read(magic, sizeof(magic));
+  return file && std::memcmp(magic, kMagic, sizeof(kMagic)) == 0;
+}
+
+void BinaryGraphFile::Write(const std::string &filename,
+                            const CsrStorage &storage) {
+  if (filename.empty()) throw std::invalid_argument("Empty filename");
+  Header header{};
+  std::memcpy(header.magic, kMagic, sizeof(kMagic));
+  header.version = kVersion;
+  header.byte_order = kByteOrder;
+  header.num_vertices = storage.GetNumVertices();
+  header.num_edges = storage.GetNumEdges();
+  header.offsets_position = sizeof(Header);
+  header.vertices_position =
+      Align(header.offsets_position +
+            (header.num_vertices + 1) * sizeof(uint64_t));
+  header.weights_position =
+      Align(header.vertices_position + header.num_edges * sizeof(uint64_t));
+  header.file_size =
+      Align(header.weights_position + header.num_edges * sizeof(uint64_t));
+
+  std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+  if (!file) throw std::invalid_argument("File write error.");
+  const std::vector<char> padding(kAlignment, 0);
+  auto write_array = [&](uint64_t position, const size_t *data, size_t size) {
+    uint64_t current = static_cast<uint64_t>(file.tellp());
+    file.write(padding.data(), position - current);
+    file.write(reinterpret_cast<const char *>(data), size * sizeof(size_t));
+  };
+  file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+  write_array(header.offsets_position, storage.GetOffsets(),
+              header.num_vertices + 1);
+  write_array(header.vertices_position, storage.GetVertices(),
+              header.num_edges);
+  write_array(header.weights_position, storage.GetWeights(), header.num_edges);
+  write_array(header.file_size, nullptr, 0);
+  if (!file) throw std::invalid_argument("File write error.");
+}
+
+std::shared_ptr<const CsrStorage> BinaryGraphFile::Map(
+    const std::string &filename) {
+  auto file = std::make_shared<const MappedFile>(filename);
+  if (file->size() < sizeof(Header)) {
+    throw std::invalid_argument("File read error. The file is too short.");
+  }
+  Header header;
+  std::memcpy(&header, file->data(), sizeof(header));
+  if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0) {
+    throw std::invalid_argument("File read error. Not a binary graph file.");
+  }
+  if (header.version != kVersion || header.byte_order != kByteOrder) {
+    throw std::invalid_argument(
+        "File read error. Unsupported binary graph version.");
+  }
+  uint64_t vertices = header.num_vertices;
+  uint64_t edges = header.num_edges;
+  uint64_t max_elements = file->size() / sizeof(uint64_t);
+  auto array_fits = [&](uint64_t position, uint64_t size) {
+    return position % kAlignment == 0 && size <= max_elements &&
+           position <= file->size() - size * sizeof(uint64_t);
+  };
+  if (vertices < 1 || vertices >= max_elements ||
+      header.file_size != file->size() ||
+      !array_fits(header.offsets_position, vertices + 1) ||
+      !array_fits(header.vertices_position, edges) ||
+      !array_fits(header.weights_position, edges)) {
+    throw std::invalid_argument("File read error. The file is corrupted.");
+  }
+  const size_t *offsets =
+      reinterpret_cast<const size_t *>(file->data() + header.offsets_position);
+  // O(V) sanity check so that neighbour ranges never leave the arrays
+  if (offsets[0] != 0 || offsets[vertices] != edges) {
+    throw std::invalid_argument("File read error. The file is corrupted.");
+  }
+  for (uint64_t i = 0; i < vertices; ++i) {
+    if (offsets[i] > offsets[i + 1]) {
+      throw std::invalid_argument("File read error. The file is corrupted.");
+    }
+  }
+  const size_t *targets =
+      reinterpret_cast<const size_t *>(file->data() + header.vertices_position);
+  const size_t *weights =
+      reinterpret_cast<const size_t *>(file->data() + header.weights_position);
+  // O(E) check of what the algorithms index with and GetEdge searches:
+  // targets in range, strictly increasing per row, and no zero weights
+  for (uint64_t i = 0; i < vertices; ++i) {
+    for (uint64_t k = offsets[i]; k < offsets[i + 1]; ++k) {
+      if (targets[k] >= vertices || weights[k] == 0 ||
+          (k > offsets[i] && targets[k - 1] >= targets[k])) {
+        throw std::invalid_argument("File read error. The file is corrupted.");
+      }
+    }
+  }
+  return std::make_shared<const CsrStorage>(file, offsets, targets, weights,
+                                            vertices);
+}
+
+uint64_t BinaryGraphFile::Align(uint64_t position) {
+  return (position + kAlignment - 1) / kAlignment * kAlignment;
+}
+
+}  // namespace s21
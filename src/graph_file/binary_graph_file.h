@@ -0,0 +1,46 @@
+#ifndef NAVIGATOR_GRAPH_FILE_BINARY_GRAPH_FILE_H_
+#define NAVIGATOR_GRAPH_FILE_BINARY_GRAPH_FILE_H_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "csr_storage.h"
+
+namespace s21 {
+
+/** BinaryGraphFile
+ *! @brief Versioned on-disk CSR graph that is mmap'ed and used in place.
+ *! Layout: 64-byte Header, then offsets[V + 1], vertices[E], weights[E]
+ *! as native-endian uint64, every array aligned to kAlignment bytes.
+ */
+class BinaryGraphFile {
+ public:
+  struct Header {
+    char magic[8];
+    uint32_t version;
+    uint32_t byte_order;
+    uint64_t num_vertices;
+    uint64_t num_edges;
+    uint64_t offsets_position;
+    uint64_t vertices_position;
+    uint64_t weights_position;
+    uint64_t file_size;
+  };
+
+  static constexpr char kMagic[8] = {'S', '2', '1', 'G', 'R', 'A', 'P', 'H'};
+  static const uint32_t kVersion = 1;
+  static const uint32_t kByteOrder = 0x01020304;
+  static const size_t kAlignment = 64;
+
+  static bool IsBinaryGraphFile(const std::string &filename);
+  static void Write(const std::string &filename, const CsrStorage &storage);
+  static std::shared_ptr<const CsrStorage> Map(const std::string &filename);
+
+ private:
+  static uint64_t Align(uint64_t position);
+};
+
+}  // namespace s21
+
+#endif  // NAVIGATOR_GRAPH_FILE_BINARY_GRAPH_FILE_H_
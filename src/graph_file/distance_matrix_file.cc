@@ -0,0 +1,101 @@
+#include "distance_matrix_file.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <cstring>
+#include <stdexcept>
+
+#include "mapped_file.h"
+
+namespace s21 {
+
+static_assert(sizeof(DistanceMatrixFile::Header) == 64,
+              "Header must fill exactly one cache line");
+
+namespace {
+
+void WriteAll(int fd, const void *data, size_t size, uint64_t position) {
+  const char *bytes = static_cast<const char *>(data);
+  while (size > 0) {
+    ssize_t written = pwrite(fd, bytes, size, position);
+    if (written <= 0) throw std::invalid_argument("File write error.");
+    bytes += written;
+    size -= written;
+    position += written;
+  }
+}
+
+}  // namespace
+
+DistanceMatrixFile::Writer::Writer(const std::string &filename, size_t rows,
+                                   size_t cols)
+    : rows_(rows), cols_(cols) {
+  if (filename.empty()) throw std::invalid_argument("Empty filename");
+  fd_ = open(filename.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  if (fd_ < 0) throw std::invalid_argument("File write error.");
+  Header header{};
+  std::memcpy(header.magic, kMagic, sizeof(kMagic));
+  header.version = kVersion;
+  header.byte_order = kByteOrder;
+  header.rows = rows;
+  header.cols = cols;
+  try {
+    WriteAll(fd_, &header, sizeof(header), 0);
+    off_t size = sizeof(Header) + rows * cols * sizeof(uint64_t);
+    if (ftruncate(fd_, size) != 0) {
+      throw std::invalid_argument("File write error.");
+    }
+  } catch (...) {
+    close(fd_);
+    throw;
+  }
+}
+
+DistanceMatrixFile::Writer::~Writer() { close(fd_); }
+
+void DistanceMatrixFile::Writer::WriteRows(size_t first_row,
+                                           const BasicMatrix<size_t> &block) {
+  if (block.GetCols() != cols_ || first_row > rows_ ||
+      block.GetRows() > rows_ - first_row) {
+    throw std::out_of_range("Rows out of range");
+  }
+  // matrix rows are padded, the file rows are not
+  for (size_t i = 0; i < block.GetRows(); ++i) {
+    WriteAll(fd_, block[i].data(), cols_ * sizeof(uint64_t),
+             sizeof(Header) + (first_row + i) * cols_ * sizeof(uint64_t));
+  }
+}
+
+BasicMatrix<size_t> DistanceMatrixFile::Read(const std::string &filename) {
+  MappedFile file(filename);
+  Header header;
+  if (file.size() < sizeof(header)) {
+    throw std::invalid_argument("File read error. The file is too short.");
+  }
+  std::memcpy(&header, file.data(), sizeof(header));
+  if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0) {
+    throw std::invalid_argument(
+        "File read error. Not a distance matrix file.");
+  }
+  if (header.version != kVersion || header.byte_order != kByteOrder) {
+    throw std::invalid_argument(
+        "File read error. Unsupported distance matrix version.");
+  }
+  uint64_t max_elements = (file.size() - sizeof(header)) / sizeof(uint64_t);
+  if (header.rows < 1 || header.cols < 1 ||
+      header.cols > max_elements / header.rows ||
+      header.rows * header.cols != max_elements ||
+      (file.size() - sizeof(header)) % sizeof(uint64_t) != 0) {
+    throw std::invalid_argument("File read error. The file is corrupted.");
+  }
+  BasicMatrix<size_t> matrix(header.rows, header.cols);
+  const char *data = file.data() + sizeof(header);
+  for (size_t i = 0; i < header.rows; ++i) {
+    std::memcpy(matrix[i].data(), data + i * header.cols * sizeof(uint64_t),
+                header.cols * sizeof(uint64_t));
+  }
+  return matrix;
+}
+
+}  // namespace s21
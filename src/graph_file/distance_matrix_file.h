@@ -0,0 +1,56 @@
+#ifndef NAVIGATOR_GRAPH_FILE_DISTANCE_MATRIX_FILE_H_
+#define NAVIGATOR_GRAPH_FILE_DISTANCE_MATRIX_FILE_H_
+
+#include <cstdint>
+#include <string>
+
+#include "matrix.h"
+
+namespace s21 {
+
+/** DistanceMatrixFile
+ *! @brief Binary distance matrix that is written row block by row block.
+ *! Layout: 64-byte Header, then rows * cols native-endian uint64 in row
+ *! order, so row r starts at byte 64 + r * cols * 8 and blocks can be
+ *! written in any order. Pairs without a path hold UINT64_MAX.
+ */
+class DistanceMatrixFile {
+ public:
+  struct Header {
+    char magic[8];
+    uint32_t version;
+    uint32_t byte_order;
+    uint64_t rows;
+    uint64_t cols;
+    uint64_t reserved[4];
+  };
+
+  static constexpr char kMagic[8] = {'S', '2', '1', 'D', 'I', 'S', 'T', 'M'};
+  static const uint32_t kVersion = 1;
+  static const uint32_t kByteOrder = 0x01020304;
+
+  // Creates the file at its final size; positional writes let several
+  // threads store their blocks at once.
+  class Writer {
+   public:
+    Writer(const std::string &filename, size_t rows, size_t cols);
+    ~Writer();
+    Writer(const Writer &) = delete;
+    Writer &operator=(const Writer &) = delete;
+
+    // block holds rows [first_row, first_row + block.GetRows())
+    void WriteRows(size_t first_row, const BasicMatrix<size_t> &block);
+
+   private:
+    int fd_ = -1;
+    size_t rows_;
+    size_t cols_;
+  };
+
+  // Whole matrix in memory; large files are better read through MappedFile.
+  static BasicMatrix<size_t> Read(const std::string &filename);
+};
+
+}  // namespace s21
+
+#endif  // NAVIGATOR_GRAPH_FILE_DISTANCE_MATRIX_FILE_H_
@@ -0,0 +1,30 @@
+#ifndef NAVIGATOR_GRAPH_FILE_MAPPED_FILE_H_
+#define NAVIGATOR_GRAPH_FILE_MAPPED_FILE_H_
+
+#include <string>
+
+namespace s21 {
+
+/** MappedFile
+ *! @brief Read-only memory mapping of a whole file (POSIX mmap).
+ */
+class MappedFile {
+ public:
+  explicit MappedFile(const std::string &filename);
+  ~MappedFile();
+  MappedFile(const MappedFile &) = delete;
+  MappedFile &operator=(const MappedFile &) = delete;
+
+  const char *data() const { return data_; }
+  size_t size() const { return size_; }
+  // read-ahead hint for files that are scanned once from start to end
+  void AdviseSequential() const;
+
+ private:
+  const char *data_ = nullptr;
+  size_t size_ = 0;
+};
+
+}  // namespace s21
+
+#endif  // NAVIGATOR_GRAPH_FILE_MAPPED_FILE_H_
@@ -0,0 +1,150 @@
+#include "text_graph_parser.h"
+
+#include <charconv>
+#include <stdexcept>
+
+namespace s21 {
+
+TextGraphParser::TextGraphParser(const std::string &filename)
+    : file_(filename),
+      position_(file_.data()),
+      end_(file_.data() + file_.size()),
+      line_start_(position_) {
+  if (file_.size() == 0) {
+    throw std::invalid_argument("File read error. The file is empty.");
+  }
+  file_.AdviseSequential();
+}
+
+size_t TextGraphParser::ReadSize() {
+  if (!SkipBlankLines()) Error("the graph size is missing");
+  size_t size = ReadNumber();
+  FinishLine(1, 1);
+  return size;
+}
+
+void TextGraphParser::ReadRow(std::vector<size_t> &row) {
+  if (!SkipBlankLines()) {
+    Error("expected " + std::to_string(row.size()) +
+          " numbers, found end of file");
+  }
+  // hot loop on locals: one pass over the mapped bytes, no allocations
+  const char *position = position_;
+  size_t count = 0;
+  while (count < row.size()) {
+    auto [next, error] = std::from_chars(position, end_, row[count]);
+    if (error != std::errc() ||
+        (next != end_ && !IsBlank(*next) && *next != '\n')) {
+      break;
+    }
+    ++count;
+    position = next;
+    while (position != end_ && IsBlank(*position)) ++position;
+    if (position == end_ || *position == '\n') break;
+  }
+  position_ = position;
+  if (count < row.size() && !AtLineEnd()) {
+    ReadNumber();  // throws with the reason the number is malformed
+  }
+  FinishLine(row.size(), count);
+}
+
+bool TextGraphParser::ReadEdge(size_t &from, size_t &to, size_t &weight) {
+  if (!ReadVertexPair(from, to)) return false;
+  weight = 1;
+  size_t found = 2;
+  if (!AtLineEnd()) {
+    weight = ReadNumber();
+    if (weight == 0) Error("edge weight must be positive");
+    found = 3;
+  }
+  FinishLine(found, found);
+  return true;
+}
+
+bool TextGraphParser::ReadSignedEdge(size_t &from, size_t &to,
+                                     int64_t &weight) {
+  if (!ReadVertexPair(from, to)) return false;
+  weight = 1;
+  size_t found = 2;
+  if (!AtLineEnd()) {
+    weight = ReadSignedNumber();
+    found = 3;
+  }
+  FinishLine(found, found);
+  return true;
+}
+
+bool TextGraphParser::ReadVertexPair(size_t &from, size_t &to) {
+  if (!SkipBlankLines()) return false;
+  from = ReadNumber();
+  if (from == 0) Error("vertex numbers start from 1");
+  SkipSpaces();
+  if (AtLineEnd()) FinishLine(2, 1);
+  to = ReadNumber();
+  if (to == 0) Error("vertex numbers start from 1");
+  SkipSpaces();
+  return true;
+}
+
+bool TextGraphParser::SkipBlankLines() {
+  while (true) {
+    SkipSpaces();
+    if (position_ == end_) return false;
+    if (*position_ == '#' || *position_ == '%') {
+      while (!AtLineEnd()) ++position_;
+    }
+    if (position_ == end_) return false;
+    if (*position_ != '\n') return true;
+    ++position_;
+    ++line_number_;
+    line_start_ = position_;
+  }
+}
+
+void TextGraphParser::SkipSpaces() {
+  while (position_ != end_ && IsBlank(*position_)) ++position_;
+}
+
+size_t TextGraphParser::ReadNumber() {
+  size_t number = 0;
+  auto [next, error] = std::from_chars(position_, end_, number);
+  if (error == std::errc::result_out_of_range) Error("number is too large");
+  if (error != std::errc()) Error("expected a non-negative number");
+  position_ = next;
+  if (!AtLineEnd() && !IsBlank(*position_)) Error("unexpected character");
+  return number;
+}
+
+int64_t TextGraphParser::ReadSignedNumber() {
+  int64_t number = 0;
+  auto [next, error] = std::from_chars(position_, end_, number);
+  if (error == std::errc::result_out_of_range) Error("number is too large");
+  if (error != std::errc()) Error("expected a number");
+  position_ = next;
+  if (!AtLineEnd() && !IsBlank(*position_)) Error("unexpected character");
+  return number;
+}
+
+bool TextGraphParser::AtLineEnd() const {
+  return position_ == end_ || *position_ == '\n';
+}
+
+void TextGraphParser::FinishLine(size_t expected, size_t found) {
+  SkipSpaces();
+  if (found < expected) {
+    Error("expected " + std::to_string(expected) + " numbers, found " +
+          std::to_string(found));
+  }
+  if (!AtLineEnd()) {
+    Error("expected " + std::to_string(expected) + " numbers, found more");
+  }
+}
+
+void TextGraphParser::Error(const std::string &message) const {
+  throw std::invalid_argument(
+      "File read error. Line " + std::to_string(line_number_) + ", column " +
+      std::to_string(position_ - line_start_ + 1) + ": " + message + ".");
+}
+
+}  // namespace s21
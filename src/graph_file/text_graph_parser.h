@@ -0,0 +1,52 @@
+#ifndef NAVIGATOR_GRAPH_FILE_TEXT_GRAPH_PARSER_H_
+#define NAVIGATOR_GRAPH_FILE_TEXT_GRAPH_PARSER_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "mapped_file.h"
+
+namespace s21 {
+
+/** TextGraphParser
+ *! @brief Single-pass parser of the text graph formats working in place
+ *! over the mapped file with std::from_chars: .adj (size, then one matrix
+ *! row per line) and edge lists ("from to [weight]" per line). Lines
+ *! starting with '#' or '%' are comments. Errors report line and column.
+ */
+class TextGraphParser {
+ public:
+  explicit TextGraphParser(const std::string &filename);
+
+  size_t ReadSize();
+  // Fills the whole row; the line must hold exactly row.size() numbers.
+  void ReadRow(std::vector<size_t> &row);
+  // Reads "from to [weight]" with vertices numbered from 1 and a positive
+  // weight (1 if omitted); false at end of file.
+  bool ReadEdge(size_t &from, size_t &to, size_t &weight);
+  // Same line format with any signed weight, zero included.
+  bool ReadSignedEdge(size_t &from, size_t &to, int64_t &weight);
+  [[noreturn]] void Error(const std::string &message) const;
+
+ private:
+  bool SkipBlankLines();
+  void SkipSpaces();
+  size_t ReadNumber();
+  int64_t ReadSignedNumber();
+  // "from to" of an edge line, false at end of file
+  bool ReadVertexPair(size_t &from, size_t &to);
+  bool AtLineEnd() const;
+  static bool IsBlank(char c) { return c == ' ' || c == '\t' || c == '\r'; }
+  void FinishLine(size_t expected, size_t found);
+
+  MappedFile file_;
+  const char *position_;
+  const char *end_;
+  const char *line_start_;
+  size_t line_number_ = 1;
+};
+
+}  // namespace s21
+
+#endif  // NAVIGATOR_GRAPH_FILE_TEXT_GRAPH_PARSER_H_
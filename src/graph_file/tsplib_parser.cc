@@ -0,0 +1,168 @@
+#include "tsplib_parser.h"
+
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+
+namespace s21 {
+
+namespace {
+
+std::string Trim(const std::string &text) {
+  const char *kSpaces = " \t\r";
+  size_t first = text.find_first_not_of(kSpaces);
+  if (first == std::string::npos) return "";
+  return text.substr(first, text.find_last_not_of(kSpaces) - first + 1);
+}
+
+}  // namespace
+
+TsplibParser::Instance TsplibParser::Parse(const std::string &filename,
+                                           size_t memory_limit) {
+  std::ifstream file(filename);
+  if (!file) {
+    throw std::invalid_argument("File read error. The file is missing.");
+  }
+  if (file.peek() == std::ifstream::traits_type::eof()) {
+    throw std::invalid_argument("File read error. The file is empty.");
+  }
+  return TsplibParser(file, memory_limit).Parse();
+}
+
+TsplibParser::Instance TsplibParser::Parse() {
+  Instance instance;
+  std::string line;
+  while (std::getline(stream_, line)) {
+    line = Trim(line);
+    if (line.empty()) continue;
+    size_t colon = line.find(':');
+    std::string keyword = Trim(line.substr(0, colon));
+    if (keyword == "EOF") break;
+    if (keyword == "NODE_COORD_SECTION") {
+      ReadCoordinates(instance);
+    } else if (keyword == "EDGE_WEIGHT_SECTION") {
+      ReadWeights(instance);
+    } else if (keyword == "DISPLAY_DATA_SECTION") {
+      std::string skipped;
+      for (size_t i = 0; i < GetDimension(); ++i) {
+        std::getline(stream_, skipped);
+      }
+    } else if (colon == std::string::npos) {
+      Error("unsupported section " + keyword);
+    } else {
+      specification_[keyword] = Trim(line.substr(colon + 1));
+    }
+  }
+  std::string type = GetValue("TYPE");
+  if (type != "TSP" && type != "ATSP") Error("unsupported TYPE " + type);
+  if (instance.points == nullptr && instance.weights.empty()) {
+    Error("no NODE_COORD_SECTION or EDGE_WEIGHT_SECTION");
+  }
+  instance.dimension = GetDimension();
+  return instance;
+}
+
+void TsplibParser::ReadCoordinates(Instance &instance) {
+  const std::map<std::string, PointSet::Metric> kMetrics = {
+      {"EUC_2D", PointSet::Metric::kEuclidean},
+      {"CEIL_2D", PointSet::Metric::kCeilEuclidean},
+      {"ATT", PointSet::Metric::kPseudoEuclidean},
+      {"GEO", PointSet::Metric::kGeo}};
+  std::string type = GetValue("EDGE_WEIGHT_TYPE");
+  auto metric = kMetrics.find(type);
+  if (metric == kMetrics.end()) Error("unsupported EDGE_WEIGHT_TYPE " + type);
+  size_t dimension = GetDimension();
+  CheckMemoryLimit(dimension, sizeof(PointSet::Point));
+  std::vector<PointSet::Point> points(dimension);
+  std::vector<bool> seen(dimension, false);
+  for (size_t i = 0; i < dimension; ++i) {
+    size_t node = 0;
+    PointSet::Point point{};
+    if (!(stream_ >> node >> point.x >> point.y)) {
+      Error("expected " + std::to_string(dimension) + " node coordinates");
+    }
+    if (node < 1 || node > dimension || seen[node - 1]) {
+      Error("invalid node number " + std::to_string(node));
+    }
+    seen[node - 1] = true;
+    points[node - 1] = point;
+  }
+  instance.points = std::make_shared<const PointSet>(std::move(points),
+                                                     metric->second);
+}
+
+void TsplibParser::ReadWeights(Instance &instance) {
+  if (GetValue("EDGE_WEIGHT_TYPE") != "EXPLICIT") {
+    Error("EDGE_WEIGHT_SECTION requires EDGE_WEIGHT_TYPE EXPLICIT");
+  }
+  std::string format = GetValue("EDGE_WEIGHT_FORMAT");
+  size_t n = GetDimension();
+  // GetDimension keeps n * n in range
+  CheckMemoryLimit(n * n, sizeof(size_t));
+  instance.weights.assign(n * n, 0);
+  // triangular formats list (row, column) pairs in row order
+  auto read = [&](size_t row, size_t col) {
+    size_t weight = 0;
+    if (!(stream_ >> weight)) Error("not enough weights for " + format);
+    instance.weights[row * n + col] = weight;
+    instance.weights[col * n + row] = weight;
+  };
+  if (format == "FULL_MATRIX") {
+    for (size_t i = 0; i < n; ++i) {
+      for (size_t j = 0; j < n; ++j) {
+        if (!(stream_ >> instance.weights[i * n + j])) {
+          Error("not enough weights for " + format);
+        }
+      }
+    }
+  } else if (format == "UPPER_ROW" || format == "UPPER_DIAG_ROW") {
+    size_t shift = format == "UPPER_ROW" ? 1 : 0;
+    for (size_t i = 0; i < n; ++i) {
+      for (size_t j = i + shift; j < n; ++j) read(i, j);
+    }
+  } else if (format == "LOWER_ROW" || format == "LOWER_DIAG_ROW") {
+    size_t shift = format == "LOWER_ROW" ? 0 : 1;
+    for (size_t i = 0; i < n; ++i) {
+      for (size_t j = 0; j < i + shift; ++j) read(i, j);
+    }
+  } else {
+    Error("unsupported EDGE_WEIGHT_FORMAT " + format);
+  }
+}
+
+size_t TsplibParser::GetDimension() const {
+  std::string value = GetValue("DIMENSION");
+  size_t position = 0;
+  size_t dimension = 0;
+  try {
+    dimension = std::stoul(value, &position);
+  } catch (const std::exception &) {
+    position = 0;
+  }
+  // a weight matrix of the dimension must be addressable
+  if (position != value.size() || dimension < 1 ||
+      dimension > std::numeric_limits<size_t>::max() / dimension) {
+    Error("invalid DIMENSION " + value);
+  }
+  return dimension;
+}
+
+std::string TsplibParser::GetValue(const std::string &key) const {
+  auto it = specification_.find(key);
+  if (it == specification_.end()) Error(key + " is missing");
+  return it->second;
+}
+
+void TsplibParser::CheckMemoryLimit(size_t count,
+                                    size_t element_bytes) const {
+  if (count > memory_limit_ / element_bytes) {
+    throw std::invalid_argument(
+        "File read error. The graph exceeds the memory limit.");
+  }
+}
+
+void TsplibParser::Error(const std::string &message) {
+  throw std::invalid_argument("File read error. TSPLIB: " + message + ".");
+}
+
+}  // namespace s21
@@ -0,0 +1,55 @@
+#ifndef NAVIGATOR_GRAPH_FILE_TSPLIB_PARSER_H_
+#define NAVIGATOR_GRAPH_FILE_TSPLIB_PARSER_H_
+
+#include <istream>
+#include <limits>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "point_set.h"
+
+namespace s21 {
+
+/** TsplibParser
+ *! @brief Reader of TSPLIB .tsp/.atsp files: coordinate instances
+ *! (EUC_2D, CEIL_2D, ATT, GEO) and EXPLICIT weights in FULL_MATRIX and
+ *! triangular row formats.
+ */
+class TsplibParser {
+ public:
+  struct Instance {
+    size_t dimension = 0;
+    // set for coordinate instances
+    std::shared_ptr<const PointSet> points;
+    // EXPLICIT instances: dimension x dimension, row-major
+    std::vector<size_t> weights;
+  };
+
+  // Throws std::invalid_argument before allocating coordinates or weights
+  // of more than memory_limit bytes.
+  static Instance Parse(
+      const std::string &filename,
+      size_t memory_limit = std::numeric_limits<size_t>::max());
+
+ private:
+  TsplibParser(std::istream &stream, size_t memory_limit)
+      : stream_(stream), memory_limit_(memory_limit) {}
+
+  Instance Parse();
+  void ReadCoordinates(Instance &instance);
+  void ReadWeights(Instance &instance);
+  size_t GetDimension() const;
+  std::string GetValue(const std::string &key) const;
+  void CheckMemoryLimit(size_t count, size_t element_bytes) const;
+  [[noreturn]] static void Error(const std::string &message);
+
+  std::istream &stream_;
+  size_t memory_limit_;
+  std::map<std::string, std::string> specification_;
+};
+
+}  // namespace s21
+
+#endif  // NAVIGATOR_GRAPH_FILE_TSPLIB_PARSER_H_
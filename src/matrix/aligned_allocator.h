@@ -0,0 +1,43 @@
+#ifndef NAVIGATOR_MATRIX_ALIGNED_ALLOCATOR_H_
+#define NAVIGATOR_MATRIX_ALIGNED_ALLOCATOR_H_
+
+#include <cstddef>
+#include <new>
+
+/** AlignedAllocator
+ *! @brief std::allocator replacement returning Alignment-aligned blocks
+ *! (cache line by default) for vectorised row loops.
+ */
+template <typename T, size_t Alignment = 64>
+class AlignedAllocator {
+ public:
+  using value_type = T;
+
+  template <typename U>
+  struct rebind {
+    using other = AlignedAllocator<U, Alignment>;
+  };
+
+  AlignedAllocator() = default;
+  template <typename U>
+  AlignedAllocator(const AlignedAllocator<U, Alignment> &) {}
+
+  T *allocate(size_t count) {
+    return static_cast<T *>(
+        ::operator new(count * sizeof(T), std::align_val_t(Alignment)));
+  }
+  void deallocate(T *pointer, size_t) {
+    ::operator delete(pointer, std::align_val_t(Alignment));
+  }
+
+  template <typename U>
+  bool operator==(const AlignedAllocator<U, Alignment> &) const {
+    return true;
+  }
+  template <typename U>
+  bool operator!=(const AlignedAllocator<U, Alignment> &) const {
+    return false;
+  }
+};
+
+#endif  // NAVIGATOR_MATRIX_ALIGNED_ALLOCATOR_H_
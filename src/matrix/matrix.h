@@ -1,41 +1,89 @@
-#include <exception>
+#ifndef NAVIGATOR_MATRIX_MATRIX_H_
+#define NAVIGATOR_MATRIX_MATRIX_H_
+
+#include <algorithm>
+#include <initializer_list>
 #include <iostream>
+#include <stdexcept>
 #include <vector>
 
-class Matrix {
- public:
-  Matrix() : Matrix(1, 1) {}
+#include "aligned_allocator.h"
 
-  explicit Matrix(size_t size) : Matrix(size, size) {}
+/** BasicMatrix
+ *! @brief Row-major matrix in one cache-line aligned buffer. Every row
+ *! starts on a cache line: rows are GetStride() elements apart, the padding
+ *! is never read. operator() and operator[] are unchecked for inner loops,
+ *! At() checks the indices.
+ */
+template <typename T>
+class BasicMatrix {
+ public:
+  static const size_t kAlignment = 64;
+
+  // Span-style view of one row.
+  template <typename U>
+  class RowView {
+   public:
+    RowView(U *data, size_t size) : data_(data), size_(size) {}
+    // mutable rows convert to const ones
+    template <typename V>
+    RowView(const RowView<V> &other)
+        : data_(other.data()), size_(other.size()) {}
+
+    U *data() const { return data_; }
+    size_t size() const { return size_; }
+    U *begin() const { return data_; }
+    U *end() const { return data_ + size_; }
+    U &operator[](size_t index) const { return data_[index]; }
+
+   private:
+    U *data_;
+    size_t size_;
+  };
+  using Row = RowView<T>;
+  using ConstRow = RowView<const T>;
+
+  BasicMatrix() : BasicMatrix(0, 0) {}
+
+  explicit BasicMatrix(size_t size) : BasicMatrix(size, size) {}
+
+  BasicMatrix(size_t rows, size_t cols, T value = T())
+      : rows_(rows),
+        cols_(cols),
+        stride_(GetStride(cols)),
+        data_(rows * stride_, T()) {
+    if (value != T()) Fill(value);
+  }
 
-  Matrix(size_t rows, size_t cols)
-      : matrix_(rows, std::vector<double>(cols)), rows_(rows), cols_(cols) {}
+  BasicMatrix(std::initializer_list<std::initializer_list<T>> rows)
+      : BasicMatrix(rows.size(), rows.size() ? rows.begin()->size() : 0) {
+    size_t i = 0;
+    for (const auto &row : rows) {
+      if (row.size() != cols_) {
+        throw std::invalid_argument("Matrix rows have different sizes");
+      }
+      std::copy(row.begin(), row.end(), (*this)[i++].begin());
+    }
+  }
 
-  Matrix(size_t rows, size_t cols, double value)
-      : matrix_(rows, std::vector<double>(cols, value)),
-        rows_(rows),
-        cols_(cols) {}
+  // Elements between the starts of two rows with cols columns.
+  static size_t GetStride(size_t cols) {
+    const size_t line = std::max<size_t>(1, kAlignment / sizeof(T));
+    return (cols + line - 1) / line * line;
+  }
 
   size_t GetRows() const { return rows_; }
-
   size_t GetCols() const { return cols_; }
+  size_t GetStride() const { return stride_; }
 
   void SetRows(size_t rows) {
     if (rows < 1) throw std::out_of_range("Matrix rows out of range");
-    if (rows_ == rows) return;
-
-    matrix_.resize(rows, std::vector<double>(cols_, 0.0));
-    rows_ = rows;
+    Resize(rows, cols_);
   }
 
   void SetCols(size_t cols) {
     if (cols < 1) throw std::out_of_range("Matrix cols out of range");
-    if (cols_ == cols) return;
-
-    for (auto& row : matrix_) {
-      row.resize(cols, 0.0);
-    }
-    cols_ = cols;
+    Resize(rows_, cols);
   }
 
   void SetSize(size_t size) {
@@ -43,65 +91,112 @@ class Matrix {
     SetCols(size);
   }
 
-  double operator()(size_t row, size_t col) const {
-    return matrix_.at(row).at(col);
+  T operator()(size_t row, size_t col) const {
+    return data_[row * stride_ + col];
   }
+  T &operator()(size_t row, size_t col) { return data_[row * stride_ + col]; }
 
-  double& operator()(size_t row, size_t col) { return matrix_.at(row).at(col); }
+  T At(size_t row, size_t col) const {
+    CheckIndex(row, col);
+    return (*this)(row, col);
+  }
+  T &At(size_t row, size_t col) {
+    CheckIndex(row, col);
+    return (*this)(row, col);
+  }
 
-  Matrix operator*(const double number) const {
-    Matrix result(rows_, cols_);
+  Row operator[](size_t row) { return {data_.data() + row * stride_, cols_}; }
+  ConstRow operator[](size_t row) const {
+    return {data_.data() + row * stride_, cols_};
+  }
+
+  void Fill(T value) {
     for (size_t i = 0; i < rows_; ++i) {
-      for (size_t j = 0; j < cols_; ++j) {
-        result.matrix_[i][j] = matrix_[i][j] * number;
-      }
+      std::fill_n(data_.data() + i * stride_, cols_, value);
     }
+  }
+
+  BasicMatrix operator*(const T number) const {
+    BasicMatrix result(*this);
+    result.MultNumber(number);
     return result;
   }
 
-  Matrix Transpose() const {
-    size_t rows = GetCols();
-    size_t cols = GetRows();
-    Matrix result(cols, rows);
-    for (size_t i = 0; i < rows; ++i) {
-      for (size_t j = 0; j < cols; ++j) {
-        result(j, i) = (*this)(i, j);
+  BasicMatrix Transpose() const {
+    BasicMatrix result(cols_, rows_);
+    for (size_t i = 0; i < rows_; ++i) {
+      ConstRow row = (*this)[i];
+      for (size_t j = 0; j < cols_; ++j) {
+        result(j, i) = row[j];
       }
     }
     return result;
   }
 
-  void MultNumber(const double number) {
+  void MultNumber(const T number) {
     for (size_t i = 0; i < rows_; ++i) {
+      T *row = data_.data() + i * stride_;
       for (size_t j = 0; j < cols_; ++j) {
-        matrix_[i][j] *= number;
+        row[j] *= number;
       }
     }
   }
 
   void PrintMatrix() const {
-    for (const auto& row : matrix_) {
-      for (const auto& element : row) {
+    for (size_t i = 0; i < rows_; ++i) {
+      for (const auto &element : (*this)[i]) {
         std::cout << element << " ";
       }
       std::cout << std::endl;
     }
   }
 
-  void Add(const Matrix& other) {
+  void Add(const BasicMatrix &other) {
     if (rows_ != other.rows_ || cols_ != other.cols_) {
       throw std::runtime_error("Matrix sizes are not compatible for addition");
     }
-
     for (size_t i = 0; i < rows_; ++i) {
+      T *row = data_.data() + i * stride_;
+      const T *other_row = other.data_.data() + i * stride_;
       for (size_t j = 0; j < cols_; ++j) {
-        matrix_[i][j] += other.matrix_[i][j];
+        row[j] += other_row[j];
       }
     }
   }
 
+  bool operator==(const BasicMatrix &other) const {
+    if (rows_ != other.rows_ || cols_ != other.cols_) return false;
+    for (size_t i = 0; i < rows_; ++i) {
+      ConstRow row = (*this)[i];
+      if (!std::equal(row.begin(), row.end(), other[i].begin())) return false;
+    }
+    return true;
+  }
+  bool operator!=(const BasicMatrix &other) const { return !(*this == other); }
+
  private:
-  std::vector<std::vector<double>> matrix_;
+  void CheckIndex(size_t row, size_t col) const {
+    if (row >= rows_ || col >= cols_) {
+      throw std::out_of_range("Matrix index out of range");
+    }
+  }
+
+  void Resize(size_t rows, size_t cols) {
+    if (rows == rows_ && cols == cols_) return;
+    BasicMatrix result(rows, cols);
+    for (size_t i = 0; i < std::min(rows, rows_); ++i) {
+      ConstRow row = (*this)[i];
+      std::copy_n(row.begin(), std::min(cols, cols_), result[i].begin());
+    }
+    *this = std::move(result);
+  }
+
   size_t rows_;
   size_t cols_;
-};
\ No newline at end of file
+  size_t stride_;
+  std::vector<T, AlignedAllocator<T, kAlignment>> data_;
+};
+
+using Matrix = BasicMatrix<double>;
+
+#endif  // NAVIGATOR_MATRIX_MATRIX_H_
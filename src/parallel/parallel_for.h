@@ -0,0 +1,58 @@
+#ifndef NAVIGATOR_PARALLEL_PARALLEL_FOR_H_
+#define NAVIGATOR_PARALLEL_PARALLEL_FOR_H_
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace s21 {
+
+// 0 asks for one thread per hardware thread
+inline size_t GetNumThreads(size_t num_threads) {
+  if (num_threads != 0) return num_threads;
+  return std::max<size_t>(1, std::thread::hardware_concurrency());
+}
+
+/** ParallelFor
+ *! @brief Calls function(index) for every index in [begin, end) on up to
+ *! num_threads threads. Indices are handed out one at a time, so uneven
+ *! work is balanced. The first exception is rethrown to the caller once
+ *! all threads have stopped.
+ */
+template <typename Function>
+void ParallelFor(size_t begin, size_t end, size_t num_threads,
+                 Function function) {
+  if (begin >= end) return;
+  num_threads = std::min(GetNumThreads(num_threads), end - begin);
+  if (num_threads == 1) {
+    for (size_t index = begin; index < end; ++index) function(index);
+    return;
+  }
+  std::atomic<size_t> next(begin);
+  std::exception_ptr error;
+  std::mutex error_mutex;
+  auto worker = [&] {
+    try {
+      for (size_t index = next++; index < end; index = next++) {
+        function(index);
+      }
+    } catch (...) {
+      std::lock_guard<std::mutex> lock(error_mutex);
+      if (error == nullptr) error = std::current_exception();
+      next = end;
+    }
+  };
+  std::vector<std::thread> threads;
+  threads.reserve(num_threads - 1);
+  for (size_t i = 1; i < num_threads; ++i) threads.emplace_back(worker);
+  worker();
+  for (std::thread &thread : threads) thread.join();
+  if (error != nullptr) std::rethrow_exception(error);
+}
+
+}  // namespace s21
+
+#endif  // NAVIGATOR_PARALLEL_PARALLEL_FOR_H_
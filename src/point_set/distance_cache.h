@@ -0,0 +1,64 @@
+#ifndef NAVIGATOR_POINT_SET_DISTANCE_CACHE_H_
+#define NAVIGATOR_POINT_SET_DISTANCE_CACHE_H_
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+#include "point_set.h"
+
+namespace s21 {
+
+/** DistanceCache
+ *! @brief Direct-mapped cache of PointSet distances. Every slot is one
+ *! atomic word holding both the vertex pair and the distance, so graph
+ *! copies used from several threads share it without locks. Pairs of
+ *! instances above kMaxVertices and distances above kMaxDistance are
+ *! computed every time.
+ */
+class DistanceCache {
+ public:
+  static const size_t kMaxVertices = size_t{1} << 20;
+  static const uint64_t kMaxDistance = (uint64_t{1} << 24) - 1;
+
+  // Uses the largest power of two number of slots fitting into bytes.
+  explicit DistanceCache(size_t bytes) {
+    size_t slots = 1;
+    while (slots * 2 * sizeof(Slot) <= bytes) slots *= 2;
+    mask_ = slots - 1;
+    slots_ = std::make_unique<Slot[]>(slots);
+    for (size_t i = 0; i < slots; ++i) {
+      slots_[i].store(0, std::memory_order_relaxed);
+    }
+  }
+
+  size_t GetBytes() const { return (mask_ + 1) * sizeof(Slot); }
+
+  size_t GetDistance(const PointSet &points, size_t from, size_t to) const {
+    size_t size = points.size();
+    if (size > kMaxVertices || from >= size || to >= size) {
+      return points.GetDistance(from, to);
+    }
+    // the metrics are symmetric, both directions share a slot
+    uint64_t key = std::min(from, to) * size + std::max(from, to) + 1;
+    Slot &slot = slots_[(key * 0x9E3779B97F4A7C15ull >> 24) & mask_];
+    uint64_t entry = slot.load(std::memory_order_relaxed);
+    if (entry >> 24 == key) return entry & kMaxDistance;
+    size_t distance = points.GetDistance(from, to);
+    if (distance <= kMaxDistance) {
+      slot.store(key << 24 | distance, std::memory_order_relaxed);
+    }
+    return distance;
+  }
+
+ private:
+  using Slot = std::atomic<uint64_t>;
+
+  std::unique_ptr<Slot[]> slots_;
+  size_t mask_;
+};
+
+}  // namespace s21
+
+#endif  // NAVIGATOR_POINT_SET_DISTANCE_CACHE_H_
@@ -0,0 +1,79 @@
+#ifndef NAVIGATOR_POINT_SET_POINT_SET_H_
+#define NAVIGATOR_POINT_SET_POINT_SET_H_
+
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+namespace s21 {
+
+/** PointSet
+ *! @brief City coordinates with a TSPLIB distance function, rounded to
+ *! integer weights exactly as TSPLIB defines them.
+ */
+class PointSet {
+ public:
+  struct Point {
+    double x;
+    double y;
+  };
+
+  // EUC_2D, CEIL_2D, ATT and GEO edge weight types
+  enum class Metric { kEuclidean, kCeilEuclidean, kPseudoEuclidean, kGeo };
+
+  PointSet(std::vector<Point> points, Metric metric)
+      : points_(std::move(points)), metric_(metric) {}
+
+  size_t size() const { return points_.size(); }
+  Metric GetMetric() const { return metric_; }
+  const Point &operator[](size_t index) const { return points_[index]; }
+
+  size_t GetDistance(size_t from, size_t to) const {
+    if (from >= size() || to >= size()) {
+      throw std::out_of_range("Vertex out of range");
+    }
+    if (from == to) return 0;
+    const Point &a = points_[from];
+    const Point &b = points_[to];
+    double dx = a.x - b.x;
+    double dy = a.y - b.y;
+    switch (metric_) {
+      case Metric::kEuclidean:
+        return static_cast<size_t>(std::sqrt(dx * dx + dy * dy) + 0.5);
+      case Metric::kCeilEuclidean:
+        return static_cast<size_t>(std::ceil(std::sqrt(dx * dx + dy * dy)));
+      case Metric::kPseudoEuclidean: {
+        double r = std::sqrt((dx * dx + dy * dy) / 10.0);
+        double t = std::floor(r + 0.5);
+        return static_cast<size_t>(t < r ? t + 1 : t);
+      }
+      case Metric::kGeo:
+        return GeoDistance(a, b);
+    }
+    return 0;
+  }
+
+ private:
+  static double GeoRadians(double value) {
+    const double kPi = 3.141592;
+    double degrees = std::trunc(value);
+    return kPi * (degrees + 5.0 * (value - degrees) / 3.0) / 180.0;
+  }
+  static size_t GeoDistance(const Point &a, const Point &b) {
+    const double kEarthRadius = 6378.388;
+    double q1 = std::cos(GeoRadians(a.y) - GeoRadians(b.y));
+    double q2 = std::cos(GeoRadians(a.x) - GeoRadians(b.x));
+    double q3 = std::cos(GeoRadians(a.x) + GeoRadians(b.x));
+    return static_cast<size_t>(
+        kEarthRadius *
+            std::acos(0.5 * ((1.0 + q1) * q2 - (1.0 - q1) * q3)) +
+        1.0);
+  }
+
+  std::vector<Point> points_;
+  Metric metric_;
+};
+
+}  // namespace s21
+
+#endif  // NAVIGATOR_POINT_SET_POINT_SET_H_
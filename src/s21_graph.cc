@@ -1,10 +1,33 @@
 #include "s21_graph.h"
 
+#include <algorithm>
 #include <fstream>
-#include <sstream>
+#include <limits>
+
+#include "binary_graph_file.h"
+#include "text_graph_parser.h"
+#include "tsplib_parser.h"
 
 namespace s21 {
 
+namespace {
+
+size_t SaturatingMul(size_t a, size_t b) {
+  if (a != 0 && b > std::numeric_limits<size_t>::max() / a) {
+    return std::numeric_limits<size_t>::max();
+  }
+  return a * b;
+}
+
+size_t SaturatingAdd(size_t a, size_t b) {
+  if (b > std::numeric_limits<size_t>::max() - a) {
+    return std::numeric_limits<size_t>::max();
+  }
+  return a + b;
+}
+
+}  // namespace
+
 void Graph::ExportGraphToDot(const std::string& filename) {
   if (filename.empty()) throw std::invalid_argument("Empty filename");
   std::string newfile = filename + ".dot";
@@ -13,93 +36,343 @@ void Graph::ExportGraphToDot(const std::string& filename) {
   const std::string graph_type = (is_oriented ? "digraph" : "graph");
   file << graph_type << " Graph {" << std::endl;
   for (size_t i = 0; i < size_; ++i) {
-    for (size_t j = (is_oriented ? 0 : i); j < size_; ++j) {
-      if (adjacency_matrix_.at(i).at(j)) {
-        file << "    " << i + 1 << (is_oriented ? "->" : "--") << j + 1
-             << "[label=" << adjacency_matrix_.at(i).at(j) << "];" << std::endl;
+    ForEachNeighbour(i, [&](const Neighbour& neighbour) {
+      if (is_oriented || neighbour.vertex >= i) {
+        file << "    " << i + 1 << (is_oriented ? "->" : "--")
+             << neighbour.vertex + 1 << "[label=" << neighbour.weight << "];"
+             << std::endl;
       }
-    }
+    });
   }
   file << "}" << std::endl;
 }
 
+void Graph::ExportGraphToBinary(const std::string& filename) const {
+  if (filename.empty()) throw std::invalid_argument("Empty filename");
+  if (representation_ == Representation::kImplicit) {
+    throw std::logic_error(
+        "Adjacency lists are not stored for implicit graph");
+  }
+  BinaryGraphFile::Write(filename + ".bin", *adjacency_list_);
+}
+
 bool Graph::GraphOrientationCheck() const {
+  // all TSPLIB coordinate metrics are symmetric
+  if (representation_ == Representation::kImplicit) return true;
+  // Rows are sorted, so visiting rows in order meets the arcs i -> j with
+  // j > i of every row i in order too: one cursor per row matches each of
+  // them with its reverse arc j -> i in O(V + E).
+  std::vector<size_t> cursor(size_);
   for (size_t i = 0; i < size_; ++i) {
-    for (size_t j = i; j < size_; ++j) {
-      if (adjacency_matrix_.at(i).at(j) != adjacency_matrix_.at(j).at(i)) {
+    NeighbourRange row = GetNeighbours(i);
+    size_t first = 0;
+    while (first < row.size() && row[first].vertex <= i) ++first;
+    cursor[i] = first;
+    for (size_t k = 0; k < first; ++k) {
+      size_t j = row[k].vertex;
+      if (j == i) continue;
+      NeighbourRange reverse = GetNeighbours(j);
+      if (cursor[j] == reverse.size() || reverse[cursor[j]].vertex != i ||
+          reverse[cursor[j]].weight != row[k].weight) {
         return false;
       }
+      ++cursor[j];
     }
   }
+  for (size_t i = 0; i < size_; ++i) {
+    if (cursor[i] != GetNeighbours(i).size()) return false;
+  }
   return true;
 }
 
-void Graph::LoadGraphFromFile(const std::string& filename) {
-  std::ifstream file(filename);
-  if (!file) {
-    throw std::invalid_argument("File read error. The file is missing.");
+Graph::NeighbourRange Graph::GetReverseNeighbours(size_t vertex) const {
+  if (representation_ == Representation::kImplicit) {
+    throw std::logic_error(
+        "Adjacency lists are not stored for implicit graph");
   }
-  if (file.peek() == std::ifstream::traits_type::eof()) {
-    throw std::invalid_argument("File read error. The file is empty.");
+  ReverseAdjacency& reverse = *reverse_list_;
+  std::call_once(reverse.built, [this, &reverse] {
+    reverse.list = GraphOrientationCheck() ? adjacency_list_
+                                           : adjacency_list_->Transpose();
+  });
+  return reverse.list->GetNeighbours(vertex);
+}
+
+const Graph::AdjacencyMatrix& Graph::GetMatrix() const {
+  if (representation_ == Representation::kImplicit) {
+    throw std::logic_error("Adjacency matrix is not stored for implicit graph");
   }
-  std::string line = GetNonEmptyLine(file);
-  SetSize(ReadSize(line));
-  for (size_t i = 0; i < size_; ++i) {
-    line = GetNonEmptyLine(file);
-    if (CountVerticesGraph(line) < size_) {
-      throw std::invalid_argument(
-          "File read error. Number of vertices does not match graph size");
+  if (representation_ != Representation::kDense) {
+    throw std::logic_error("Adjacency matrix is not stored for sparse graph");
+  }
+  return adjacency_matrix_;
+}
+
+void Graph::LoadGraphFromFile(const std::string& filename,
+                              Representation representation) {
+  auto has_extension = [&filename](const std::string& extension) {
+    return filename.size() >= extension.size() &&
+           filename.compare(filename.size() - extension.size(),
+                            extension.size(), extension) == 0;
+  };
+  if (has_extension(".tsp") || has_extension(".atsp")) {
+    LoadGraphFromTsplibFile(filename, representation);
+    return;
+  }
+  if (has_extension(".edges")) {
+    LoadGraphFromEdgeListFile(filename, representation);
+    return;
+  }
+  if (BinaryGraphFile::IsBinaryGraphFile(filename)) {
+    LoadGraphFromBinaryFile(filename, representation);
+    return;
+  }
+  TextGraphParser parser(filename);
+  size_t size = parser.ReadSize();
+  LoadGraphFromRows(size, representation,
+                    [&parser](size_t, std::vector<size_t>& row) {
+                      parser.ReadRow(row);
+                    });
+}
+
+void Graph::LoadGraphFromEdgeListFile(const std::string& filename,
+                                      Representation representation) {
+  TextGraphParser parser(filename);
+  std::vector<Edge> edges;
+  size_t size = 0;
+  size_t from = 0;
+  size_t to = 0;
+  size_t weight = 0;
+  while (parser.ReadEdge(from, to, weight)) {
+    edges.push_back({from - 1, to - 1, weight});
+    size = std::max(size, std::max(from, to));
+    CheckMemoryLimit(Representation::kSparse, size, edges.size());
+  }
+  if (size < kMinSize) {
+    throw std::invalid_argument(
+        "File read error. The dimensions are not correct.");
+  }
+  LoadGraphFromAdjacencyList(CsrStorage::FromEdges(size, std::move(edges)),
+                             representation);
+}
+
+void Graph::LoadGraphFromTsplibFile(const std::string& filename,
+                                    Representation representation) {
+  TsplibParser::Instance instance =
+      TsplibParser::Parse(filename, memory_limit_);
+  if (instance.points != nullptr) {
+    SetPointSet(std::move(instance.points), representation);
+    return;
+  }
+  if (representation == Representation::kImplicit) {
+    throw std::invalid_argument(
+        "File read error. An implicit graph needs node coordinates.");
+  }
+  size_t size = instance.dimension;
+  const std::vector<size_t>& weights = instance.weights;
+  // a tour never uses the diagonal, so no self-loops are stored
+  LoadGraphFromRows(size, representation,
+                    [size, &weights](size_t from, std::vector<size_t>& row) {
+                      for (size_t to = 0; to < size; ++to) {
+                        row[to] = to == from ? 0 : weights[from * size + to];
+                      }
+                    });
+}
+
+void Graph::SetPointSet(std::shared_ptr<const PointSet> points,
+                        Representation representation) {
+  size_t size = points->size();
+  if (size < kMinSize) {
+    throw std::invalid_argument(
+        "File read error. The dimensions are not correct.");
+  }
+  if (representation == Representation::kAuto) {
+    representation =
+        ChooseRepresentation(representation, size, SaturatingMul(size, size));
+    if (representation == Representation::kSparse) {
+      representation = Representation::kImplicit;
     }
-    ReadLine(i, line);
   }
-  file.close();
+  if (representation != Representation::kImplicit) {
+    const PointSet* set = points.get();
+    LoadGraphFromRows(
+        size, representation,
+        [set](size_t from, std::vector<size_t>& row) {
+          for (size_t to = 0; to < row.size(); ++to) {
+            row[to] = set->GetDistance(from, to);
+          }
+        },
+        std::move(points));
+    return;
+  }
+  // the cache set for an earlier graph is allocated again for this one
+  if (SaturatingAdd(EstimateMemory(representation, size, 0),
+                    distance_cache_bytes_) > memory_limit_) {
+    throw std::invalid_argument(
+        "File read error. The graph exceeds the memory limit.");
+  }
+  std::shared_ptr<DistanceCache> distance_cache;
+  if (distance_cache_bytes_ != 0) {
+    distance_cache = std::make_shared<DistanceCache>(distance_cache_bytes_);
+  }
+  size_ = size;
+  representation_ = representation;
+  adjacency_matrix_ = AdjacencyMatrix();
+  adjacency_list_ = std::make_shared<CsrStorage>();
+  points_ = std::move(points);
+  distance_cache_ = std::move(distance_cache);
+  reverse_list_ = std::make_shared<ReverseAdjacency>();
+  path_cache_ = CreatePathCache();
 }
 
-size_t s21::Graph::CountVerticesGraph(const std::string& line) {
-  size_t count = 0;
-  std::istringstream iss(line);
-  std::string word;
-  while (iss >> word) {
-    count++;
+void Graph::SetDistanceCache(size_t bytes) {
+  if (SaturatingAdd(EstimateMemory(representation_, size_, 0), bytes) >
+      memory_limit_) {
+    throw std::invalid_argument(
+        "The distance cache exceeds the memory limit.");
+  }
+  distance_cache_bytes_ = bytes;
+  distance_cache_.reset();
+  if (representation_ == Representation::kImplicit && bytes != 0) {
+    distance_cache_ = std::make_shared<DistanceCache>(bytes);
   }
-  return count;
 }
 
-std::string Graph::GetNonEmptyLine(std::ifstream& file) {
-  std::string line;
-  std::getline(file, line);
-  while (line.empty()) {
-    std::getline(file, line);
+void Graph::SetShortestPathCache(size_t bytes) {
+  if (SaturatingAdd(EstimateMemory(representation_, size_, GetNumEdges()),
+                    bytes) > memory_limit_) {
+    throw std::invalid_argument(
+        "The shortest path cache exceeds the memory limit.");
   }
-  return line;
+  path_cache_bytes_ = bytes;
+  path_cache_ = CreatePathCache();
 }
 
-void Graph::ReadLine(const size_t& line_number, const std::string& line) {
-  size_t num_size = 0;
-  size_t line_index = 0;
-  for (size_t col_index = 0; col_index < size_; ++col_index) {
-    size_t number = std::stoi(&line.at(line_index), &num_size);
-    adjacency_matrix_.at(line_number).at(col_index) = number;
-    line_index += num_size;
+std::shared_ptr<ShortestPathCache> Graph::CreatePathCache() const {
+  if (path_cache_bytes_ == 0) return nullptr;
+  return std::make_shared<ShortestPathCache>(path_cache_bytes_);
+}
+
+void Graph::LoadGraphFromBinaryFile(const std::string& filename,
+                                    Representation representation) {
+  // mapped lists are used in place, the matrix only on explicit request
+  if (representation == Representation::kAuto) {
+    representation = Representation::kSparse;
   }
+  LoadGraphFromAdjacencyList(BinaryGraphFile::Map(filename), representation);
 }
 
-size_t Graph::ReadSize(const std::string& line) {
-  size_t position = 0;
-  size_t size = std::stoi(&line.at(position), &position);
-  if (size < kMinSize || size > kMaxSize) {
+void Graph::LoadGraphFromRows(size_t size, Representation representation,
+                              const RowReader& read_row,
+                              std::shared_ptr<const PointSet> points) {
+  if (size < kMinSize) {
     throw std::invalid_argument(
         "File read error. The dimensions are not correct.");
   }
-  return size;
+  representation =
+      ChooseRepresentation(representation, size, SaturatingMul(size, size));
+  CheckMemoryLimit(representation, size, 0);
+  AdjacencyMatrix matrix;
+  if (representation == Representation::kDense) {
+    matrix = AdjacencyMatrix(size, size);
+  }
+  CsrStorage::Builder adjacency_list;
+  adjacency_list.Reserve(size, 0);
+  std::vector<size_t> row(size);
+  for (size_t i = 0; i < size; ++i) {
+    read_row(i, row);
+    for (size_t j = 0; j < size; ++j) {
+      adjacency_list.AddEdge(j, row[j]);
+    }
+    adjacency_list.FinishRow();
+    CheckMemoryLimit(representation, size, adjacency_list.GetNumEdges());
+    if (representation == Representation::kDense) {
+      std::copy(row.begin(), row.end(), matrix[i].begin());
+    }
+  }
+  size_ = size;
+  representation_ = representation;
+  adjacency_matrix_ = std::move(matrix);
+  adjacency_list_ = adjacency_list.Build();
+  points_ = std::move(points);
+  distance_cache_.reset();
+  reverse_list_ = std::make_shared<ReverseAdjacency>();
+  path_cache_ = CreatePathCache();
 }
 
-void Graph::SetSize(size_t size) {
+void Graph::LoadGraphFromAdjacencyList(
+    std::shared_ptr<const CsrStorage> adjacency_list,
+    Representation representation) {
+  size_t size = adjacency_list->GetNumVertices();
+  size_t edges = adjacency_list->GetNumEdges();
+  representation = ChooseRepresentation(representation, size, edges);
+  CheckMemoryLimit(representation, size, edges);
+  AdjacencyMatrix matrix;
+  if (representation == Representation::kDense) {
+    matrix = AdjacencyMatrix(size, size);
+    for (size_t i = 0; i < size; ++i) {
+      for (const auto& neighbour : adjacency_list->GetNeighbours(i)) {
+        matrix.At(i, neighbour.vertex) = neighbour.weight;
+      }
+    }
+  }
   size_ = size;
-  adjacency_matrix_.resize(size);
-  for (auto& row : adjacency_matrix_) {
-    row.resize(size, 0);
+  representation_ = representation;
+  adjacency_matrix_ = std::move(matrix);
+  adjacency_list_ = std::move(adjacency_list);
+  points_.reset();
+  distance_cache_.reset();
+  reverse_list_ = std::make_shared<ReverseAdjacency>();
+  path_cache_ = CreatePathCache();
+}
+
+Graph::Representation Graph::ChooseRepresentation(
+    Representation representation, size_t vertices, size_t edges) const {
+  if (representation != Representation::kAuto) return representation;
+  bool dense_fits =
+      EstimateMemory(Representation::kDense, vertices, edges) <= memory_limit_;
+  return dense_fits ? Representation::kDense : Representation::kSparse;
+}
+
+void Graph::CheckMemoryLimit(Representation representation, size_t vertices,
+                             size_t edges) const {
+  if (EstimateMemory(representation, vertices, edges) > memory_limit_) {
+    throw std::invalid_argument(
+        "File read error. The graph exceeds the memory limit.");
   }
 }
 
+size_t Graph::EstimateMemory(Representation representation, size_t vertices,
+                             size_t edges) {
+  if (representation == Representation::kImplicit) {
+    return SaturatingMul(vertices, sizeof(PointSet::Point));
+  }
+  // CSR: offsets + (vertex, weight) per edge
+  size_t bytes = SaturatingAdd(SaturatingMul(vertices + 1, sizeof(size_t)),
+                               SaturatingMul(edges, 2 * sizeof(size_t)));
+  if (representation != Representation::kSparse) {
+    size_t row_bytes =
+        SaturatingMul(AdjacencyMatrix::GetStride(vertices), sizeof(size_t));
+    bytes = SaturatingAdd(bytes, SaturatingMul(vertices, row_bytes));
+  }
+  return bytes;
+}
+
+void Graph::SetSize(size_t size) {
+  CheckMemoryLimit(Representation::kDense, size, 0);
+  AdjacencyMatrix matrix(size, size);
+  size_t kept = std::min(size, adjacency_matrix_.GetRows());
+  for (size_t i = 0; i < kept; ++i) {
+    std::copy_n(adjacency_matrix_[i].begin(), kept, matrix[i].begin());
+  }
+  size_ = size;
+  representation_ = Representation::kDense;
+  adjacency_matrix_ = std::move(matrix);
+  adjacency_list_ = std::make_shared<CsrStorage>(adjacency_matrix_);
+  points_.reset();
+  distance_cache_.reset();
+  reverse_list_ = std::make_shared<ReverseAdjacency>();
+  path_cache_ = CreatePathCache();
+}
+
 }  // namespace s21
@@ -1,11 +1,18 @@
 #ifndef NAVIGATOR_S21_GRAPH_H_
 #define NAVIGATOR_S21_GRAPH_H_
 
+#include <functional>
+#include <memory>
+#include <mutex>
 #include <numeric>
 #include <string>
 #include <vector>
 
+#include "csr_storage.h"
+#include "distance_cache.h"
 #include "matrix.h"
+#include "point_set.h"
+#include "shortest_path_cache.h"
 
 namespace s21 {
 
@@ -15,41 +22,164 @@ namespace s21 {
  */
 class Graph {
  public:
-  using AdjacencyMatrix = std::vector<std::vector<size_t>>;
+  using AdjacencyMatrix = BasicMatrix<size_t>;
+  using Neighbour = CsrStorage::Neighbour;
+  using NeighbourRange = CsrStorage::NeighbourRange;
+  using Edge = CsrStorage::Edge;
+
+  // kDense keeps the adjacency matrix (O(1) GetEdge) plus adjacency lists,
+  // kSparse keeps only the CSR adjacency lists (O(V + E) memory),
+  // kImplicit keeps only city coordinates (O(V) memory) of a complete graph
+  // and computes GetEdge on demand,
+  // kAuto picks kDense while its worst case fits the memory limit.
+  enum class Representation { kDense, kSparse, kImplicit, kAuto };
 
   static const size_t kMinSize = 1;
-  static const size_t kMaxSize = 100;  //! To be defined!
+  static const size_t kDefaultMemoryLimit = size_t{1} << 30;  // 1 GiB
 
-  Graph() : size_(){};
-  explicit Graph(size_t size) : size_(size) { SetSize(size_); };
+  Graph() : size_(), adjacency_list_(std::make_shared<CsrStorage>()){};
+  explicit Graph(size_t size) : Graph() { SetSize(size); };
 
   size_t size() const { return size_; }
-  size_t GetNumVertices() const { return adjacency_matrix_.size(); }
+  size_t GetNumVertices() const { return size_; }
+  size_t GetNumEdges() const {
+    if (representation_ == Representation::kImplicit) {
+      return size_ * (size_ - 1);
+    }
+    return adjacency_list_->GetNumEdges();
+  }
   std::vector<size_t> GetVertices() const {
     auto vertexes = std::vector<size_t>(GetNumVertices());
     std::iota(vertexes.begin(), vertexes.end(), 0);
     return vertexes;
   }
+  Representation GetRepresentation() const { return representation_; }
+  size_t GetMemoryLimit() const { return memory_limit_; }
+  void SetMemoryLimit(size_t bytes) { memory_limit_ = bytes; }
+  static size_t EstimateMemory(Representation representation,
+                               size_t vertices, size_t edges);
   void SetSize(size_t size);
   size_t GetEdge(size_t from, size_t to) const {
-    return adjacency_matrix_.at(from).at(to);
+    switch (representation_) {
+      case Representation::kSparse:
+        return adjacency_list_->GetEdge(from, to);
+      case Representation::kImplicit:
+        if (distance_cache_ != nullptr) {
+          return distance_cache_->GetDistance(*points_, from, to);
+        }
+        return points_->GetDistance(from, to);
+      default:
+        return adjacency_matrix_.At(from, to);
+    }
+  }
+  // Not available for implicit graphs, see ForEachNeighbour.
+  NeighbourRange GetNeighbours(size_t vertex) const {
+    if (representation_ == Representation::kImplicit) {
+      throw std::logic_error(
+          "Adjacency lists are not stored for implicit graph");
+    }
+    return adjacency_list_->GetNeighbours(vertex);
+  }
+  // Edges entering vertex: the transposed lists are built on first use and
+  // shared by copies; a symmetric graph reuses its own lists.
+  NeighbourRange GetReverseNeighbours(size_t vertex) const;
+  // Calls function(Neighbour) for every edge leaving vertex in any
+  // representation; an implicit graph computes the whole row.
+  template <typename Function>
+  void ForEachNeighbour(size_t vertex, Function function) const {
+    if (representation_ != Representation::kImplicit) {
+      for (const auto& neighbour : GetNeighbours(vertex)) function(neighbour);
+      return;
+    }
+    for (size_t to = 0; to < size_; ++to) {
+      size_t weight = GetEdge(vertex, to);
+      if (weight != 0) function(Neighbour{to, weight});
+    }
+  }
+  // ForEachNeighbour over the edges entering vertex; implicit graphs are
+  // symmetric, so their rows are the same both ways.
+  template <typename Function>
+  void ForEachReverseNeighbour(size_t vertex, Function function) const {
+    if (representation_ == Representation::kImplicit) {
+      ForEachNeighbour(vertex, function);
+      return;
+    }
+    for (const auto& neighbour : GetReverseNeighbours(vertex)) {
+      function(neighbour);
+    }
   }
 
-  const AdjacencyMatrix& GetMatrix() const { return adjacency_matrix_; }
+  const AdjacencyMatrix& GetMatrix() const;
+  // City coordinates of a TSPLIB coordinate instance, nullptr otherwise.
+  const PointSet* GetPointSet() const { return points_.get(); }
+  // Complete graph of the points; kAuto picks kDense while it fits the
+  // memory limit and kImplicit otherwise.
+  void SetPointSet(std::shared_ptr<const PointSet> points,
+                   Representation representation = Representation::kAuto);
+  // Caches up to bytes of computed distances of implicit graphs, 0 disables.
+  void SetDistanceCache(size_t bytes);
+  // Keeps shortest-path trees of up to bytes for repeated queries from the
+  // same source, 0 disables; the trees are dropped on every reload.
+  void SetShortestPathCache(size_t bytes);
+  // nullptr while disabled; shared by copies like the adjacency lists
+  ShortestPathCache* GetShortestPathCache() const { return path_cache_.get(); }
 
   void ExportGraphToDot(const std::string& filename);
+  void ExportGraphToBinary(const std::string& filename) const;
   bool GraphOrientationCheck() const;
-  void LoadGraphFromFile(const std::string& filename);
+  // Picks the format by extension: .tsp/.atsp are TSPLIB, .edges are edge
+  // lists; otherwise a binary graph or an adjacency matrix text file.
+  void LoadGraphFromFile(
+      const std::string& filename,
+      Representation representation = Representation::kAuto);
+  // "from to [weight]" per line, vertices numbered from 1, directed arcs;
+  // the number of vertices is the largest vertex number.
+  void LoadGraphFromEdgeListFile(
+      const std::string& filename,
+      Representation representation = Representation::kAuto);
+  // Complete graph of a TSPLIB instance with the TSPLIB rounded distances;
+  // coordinate instances are loaded through SetPointSet.
+  void LoadGraphFromTsplibFile(
+      const std::string& filename,
+      Representation representation = Representation::kAuto);
 
  private:
-  size_t CountVerticesGraph(const std::string& sentence);
-  std::string GetNonEmptyLine(std::ifstream& file);
-  void ReadLine(const size_t& line_number, const std::string& line);
-  size_t ReadSize(const std::string& line);
+  using RowReader = std::function<void(size_t, std::vector<size_t>&)>;
+
+  void LoadGraphFromBinaryFile(const std::string& filename,
+                               Representation representation);
+  void LoadGraphFromRows(size_t size, Representation representation,
+                         const RowReader& read_row,
+                         std::shared_ptr<const PointSet> points = nullptr);
+  void LoadGraphFromAdjacencyList(
+      std::shared_ptr<const CsrStorage> adjacency_list,
+      Representation representation);
+  Representation ChooseRepresentation(Representation representation,
+                                      size_t vertices, size_t edges) const;
+  void CheckMemoryLimit(Representation representation, size_t vertices,
+                        size_t edges) const;
+  // empty cache for a freshly loaded graph, nullptr while disabled
+  std::shared_ptr<ShortestPathCache> CreatePathCache() const;
 
   AdjacencyMatrix adjacency_matrix_;
   size_t size_ = 0;  //! что это за размер - плохое название переменной - через
                      //! месяц забыл о чем она
+  Representation representation_ = Representation::kDense;
+  size_t memory_limit_ = kDefaultMemoryLimit;
+  // Immutable after loading, so copies of the graph share it.
+  std::shared_ptr<const CsrStorage> adjacency_list_;
+  std::shared_ptr<const PointSet> points_;
+  struct ReverseAdjacency {
+    std::once_flag built;
+    std::shared_ptr<const CsrStorage> list;
+  };
+  std::shared_ptr<ReverseAdjacency> reverse_list_ =
+      std::make_shared<ReverseAdjacency>();
+  // Shared by copies, like the adjacency lists; safe for concurrent use.
+  std::shared_ptr<DistanceCache> distance_cache_;
+  size_t distance_cache_bytes_ = 0;
+  std::shared_ptr<ShortestPathCache> path_cache_;
+  size_t path_cache_bytes_ = 0;
 };
 
 }  // namespace s21
@@ -1,13 +1,24 @@
 #include "s21_graph_algorithms.h"
 
 #include <algorithm>
+#include <functional>
 #include <limits>
 #include <queue>
 #include <stack>
 #include <stdexcept>
+#include <tuple>
 
 #include "ant_colony_algorithm.h"
+#include "boruvka.h"
+#include "branch_and_bound.h"
+#include "dijkstra_search.h"
+#include "disjoint_set.h"
+#include "edge_sort.h"
+#include "floyd_warshall.h"
+#include "held_karp.h"
+#include "local_search.h"
 #include "monte_carlo_algorithm.h"
+#include "parallel_for.h"
 #include "s21_queue.h"
 #include "s21_stack.h"
 
@@ -17,6 +28,16 @@
 
 namespace s21 {
 
+NegativeCycleError::NegativeCycleError(std::vector<size_t> cycle)
+    : std::domain_error([&cycle] {
+        std::string message = "The graph has a negative cycle:";
+        for (size_t vertex : cycle) {
+          message += " " + std::to_string(vertex) + " ->";
+        }
+        return message + " " + std::to_string(cycle.front());
+      }()),
+      cycle_(std::move(cycle)) {}
+
 GraphAlgorithms::ResultArray &GraphAlgorithms::AddVertexStartNumber(
     ResultArray &array) {
   std::transform(array.begin(), array.end(), array.begin(),
@@ -39,13 +60,13 @@ GraphAlgorithms::ResultArray GraphAlgorithms::BreadthFirstSearch(
   while (!queue.empty()) {
     size_t current = queue.front();
     queue.pop();
-    for (size_t i = 0; i < graph.size(); i++) {
-      if (graph.GetEdge(current, i) != 0 && !visited[i]) {
-        queue.push(i);
-        visited[i] = true;
-        path.push_back(i);
+    graph.ForEachNeighbour(current, [&](const Graph::Neighbour &neighbour) {
+      if (!visited[neighbour.vertex]) {
+        queue.push(neighbour.vertex);
+        visited[neighbour.vertex] = true;
+        path.push_back(neighbour.vertex);
       }
-    }
+    });
   }
 
   return GraphAlgorithms::AddVertexStartNumber(path);
@@ -60,20 +81,36 @@ GraphAlgorithms::ResultArray GraphAlgorithms::DepthFirstSearch(
   if (start_vertex < 0 || start_vertex >= +(int)graph.size()) {
     throw std::invalid_argument("Vertex is out of range");
   }
+  // next unexamined neighbour of each vertex, so every edge is seen once
+  std::vector<size_t> next_neighbour(graph.size(), 0);
+  const bool implicit =
+      graph.GetRepresentation() == Graph::Representation::kImplicit;
   stack.push(start_vertex);
   visited[start_vertex] = true;
   path.push_back(start_vertex);
   while (!stack.empty()) {
     size_t current = stack.top();
-    for (size_t i = 0; i < graph.size(); i++) {
-      if (graph.GetEdge(current, i) != 0 && !visited[i]) {
-        stack.push(i);
-        visited[i] = true;
-        path.push_back(i);
-        break;
+    size_t &i = next_neighbour[current];
+    size_t next = kNoVertex;
+    if (implicit) {
+      // computed rows have no lists, so i is the next vertex number to try
+      while (i < graph.size() &&
+             (visited[i] || graph.GetEdge(current, i) == 0)) {
+        ++i;
       }
+      if (i < graph.size()) next = i;
+    } else {
+      Graph::NeighbourRange neighbours = graph.GetNeighbours(current);
+      while (i < neighbours.size() && visited[neighbours[i].vertex]) {
+        ++i;
+      }
+      if (i < neighbours.size()) next = neighbours[i].vertex;
     }
-    if (current == stack.top()) {
+    if (next != kNoVertex) {
+      stack.push(next);
+      visited[next] = true;
+      path.push_back(next);
+    } else {
       stack.pop();
     }
   }
@@ -82,113 +119,565 @@ GraphAlgorithms::ResultArray GraphAlgorithms::DepthFirstSearch(
 }
 
 GraphAlgorithms::Result GraphAlgorithms::GetShortestPathBetweenVertices(
-    const Graph &graph, int vertex1, int vertex2) {
-  size_t size = graph.size();
-  if (vertex1 < 1 || vertex1 > (int)size || vertex2 < 1 ||
-      vertex2 > (int)size) {
+    const Graph &graph, int vertex1, int vertex2, PathStrategy strategy) {
+  CheckVertex(graph.size(), vertex1);
+  CheckVertex(graph.size(), vertex2);
+  size_t source = vertex1 - kVertexStartNumber;
+  size_t target = vertex2 - kVertexStartNumber;
+  if (strategy == PathStrategy::kBidirectional) {
+    return RunBidirectionalDijkstra(graph, source, target).distance;
+  }
+  if (GetTreeCache(graph) != nullptr) {
+    return GetShortestPathTree(graph, source)->distance[target];
+  }
+  thread_local DijkstraSearch search;
+  RunDijkstra(graph, source, target, search);
+  return search.distance[target];
+}
+
+GraphAlgorithms::PathResult GraphAlgorithms::GetShortestPath(
+    const Graph &graph, int vertex1, int vertex2, PathStrategy strategy) {
+  CheckVertex(graph.size(), vertex1);
+  CheckVertex(graph.size(), vertex2);
+  size_t source = vertex1 - kVertexStartNumber;
+  size_t target = vertex2 - kVertexStartNumber;
+  PathResult result;
+  if (strategy == PathStrategy::kBidirectional) {
+    result = RunBidirectionalDijkstra(graph, source, target);
+  } else if (GetTreeCache(graph) != nullptr) {
+    auto tree = GetShortestPathTree(graph, source);
+    result = GetSearchPath(tree->distance, tree->predecessor, target);
+  } else {
+    thread_local DijkstraSearch search;
+    RunDijkstra(graph, source, target, search);
+    result = GetSearchPath(search.distance, search.predecessor, target);
+  }
+  AddVertexStartNumber(result.vertices);
+  return result;
+}
+
+Graph::AdjacencyMatrix GraphAlgorithms::GetDistanceTable(
+    const Graph &graph, const ResultArray &sources,
+    const ResultArray &targets, size_t num_threads) {
+  ResultArray source_vertices = ToInternalVertices(graph.size(), sources);
+  ResultArray target_vertices = ToInternalVertices(graph.size(), targets);
+  std::vector<char> is_target(graph.size(), false);
+  size_t num_targets = 0;
+  for (size_t target : target_vertices) {
+    if (!is_target[target]) ++num_targets;
+    is_target[target] = true;
+  }
+  Graph::AdjacencyMatrix table(sources.size(), targets.size());
+  ParallelFor(0, sources.size(), num_threads, [&](size_t i) {
+    thread_local DijkstraSearch search;
+    search.Reset(graph.size());
+    search.Label(source_vertices[i], 0, kNoVertex);
+    size_t remaining = num_targets;
+    size_t current = 0;
+    while (search.PopSettled(current)) {
+      if (is_target[current] && --remaining == 0) break;
+      size_t current_distance = search.distance[current];
+      graph.ForEachNeighbour(current, [&](const Graph::Neighbour &neighbour) {
+        size_t temp = current_distance + neighbour.weight;
+        if (temp < search.distance[neighbour.vertex]) {
+          search.Label(neighbour.vertex, temp, current);
+        }
+      });
+    }
+    for (size_t j = 0; j < target_vertices.size(); ++j) {
+      table(i, j) = search.distance[target_vertices[j]];
+    }
+  });
+  return table;
+}
+
+Graph::AdjacencyMatrix GraphAlgorithms::GetDistanceTable(
+    const ContractionHierarchy &hierarchy, const ResultArray &sources,
+    const ResultArray &targets, size_t num_threads) {
+  return hierarchy.GetDistanceTable(
+      ToInternalVertices(hierarchy.GetNumVertices(), sources),
+      ToInternalVertices(hierarchy.GetNumVertices(), targets), num_threads);
+}
+
+LandmarkHeuristic GraphAlgorithms::BuildLandmarkHeuristic(
+    const Graph &graph, size_t num_landmarks) {
+  return LandmarkHeuristic(graph, num_landmarks);
+}
+
+GraphAlgorithms::Result GraphAlgorithms::GetShortestPathBetweenVertices(
+    const Graph &graph, int vertex1, int vertex2,
+    const PathHeuristic &heuristic) {
+  CheckVertex(graph.size(), vertex1);
+  CheckVertex(graph.size(), vertex2);
+  size_t target = vertex2 - kVertexStartNumber;
+  thread_local DijkstraSearch search;
+  RunAStar(graph, vertex1 - kVertexStartNumber, target, heuristic, search);
+  return search.distance[target];
+}
+
+GraphAlgorithms::PathResult GraphAlgorithms::GetShortestPath(
+    const Graph &graph, int vertex1, int vertex2,
+    const PathHeuristic &heuristic) {
+  CheckVertex(graph.size(), vertex1);
+  CheckVertex(graph.size(), vertex2);
+  size_t target = vertex2 - kVertexStartNumber;
+  thread_local DijkstraSearch search;
+  RunAStar(graph, vertex1 - kVertexStartNumber, target, heuristic, search);
+  PathResult result =
+      GetSearchPath(search.distance, search.predecessor, target);
+  AddVertexStartNumber(result.vertices);
+  return result;
+}
+
+ContractionHierarchy GraphAlgorithms::BuildContractionHierarchy(
+    const Graph &graph) {
+  return ContractionHierarchy(graph);
+}
+
+GraphAlgorithms::Result GraphAlgorithms::GetShortestPathBetweenVertices(
+    const ContractionHierarchy &hierarchy, int vertex1, int vertex2) {
+  CheckVertex(hierarchy.GetNumVertices(), vertex1);
+  CheckVertex(hierarchy.GetNumVertices(), vertex2);
+  return hierarchy.GetDistance(vertex1 - kVertexStartNumber,
+                               vertex2 - kVertexStartNumber);
+}
+
+GraphAlgorithms::PathResult GraphAlgorithms::GetShortestPath(
+    const ContractionHierarchy &hierarchy, int vertex1, int vertex2) {
+  CheckVertex(hierarchy.GetNumVertices(), vertex1);
+  CheckVertex(hierarchy.GetNumVertices(), vertex2);
+  size_t source = vertex1 - kVertexStartNumber;
+  size_t target = vertex2 - kVertexStartNumber;
+  PathResult result;
+  result.vertices = hierarchy.GetPath(source, target, &result.distance);
+  AddVertexStartNumber(result.vertices);
+  return result;
+}
+
+GraphAlgorithms::ResultArray GraphAlgorithms::ToInternalVertices(
+    size_t num_vertices, const ResultArray &vertices) {
+  ResultArray result(vertices.size());
+  for (size_t i = 0; i < vertices.size(); ++i) {
+    if (vertices[i] < kVertexStartNumber ||
+        vertices[i] >= num_vertices + kVertexStartNumber) {
+      throw std::invalid_argument("Vertex is out of range");
+    }
+    result[i] = vertices[i] - kVertexStartNumber;
+  }
+  return result;
+}
+
+void GraphAlgorithms::CheckVertex(size_t num_vertices, int vertex) {
+  if (vertex < (int)kVertexStartNumber ||
+      vertex >= (int)(num_vertices + kVertexStartNumber)) {
     throw std::invalid_argument("Vertex is out of range");
   }
-  vertex1 -= kVertexStartNumber;
-  vertex2 -= kVertexStartNumber;
-  std::vector<bool> visited(size, false);
-  std::vector<size_t> distance(size, SIZE_T_MAX);
-  distance.at(vertex1) = 0;
-  while (true) {
-    size_t min_index = SIZE_T_MAX;
-    size_t min_dist = SIZE_T_MAX;
-    for (size_t i = 0; i < size; i++) {
-      if (!visited.at(i) && (distance.at(i) < min_dist)) {
-        min_dist = distance.at(i);
-        min_index = i;
-      }
+}
+
+void GraphAlgorithms::RunDijkstra(const Graph &graph, size_t source,
+                                  size_t target, DijkstraSearch &search) {
+  search.Run(graph.size(), source, target,
+             [&graph](size_t vertex, auto function) {
+               graph.ForEachNeighbour(vertex, function);
+             });
+}
+
+void GraphAlgorithms::RunAStar(const Graph &graph, size_t source,
+                               size_t target, const PathHeuristic &heuristic,
+                               DijkstraSearch &search) {
+  if (heuristic.GetNumVertices() != graph.size()) {
+    throw std::invalid_argument("The heuristic does not match the graph");
+  }
+  search.Reset(graph.size());
+  search.Label(source, 0, kNoVertex, heuristic.Estimate(source, target));
+  while (!search.heap.empty()) {
+    DijkstraSearch::Entry entry = search.Pop();
+    size_t current = entry.second;
+    size_t current_distance = search.distance[current];
+    // the key of the latest label, older entries are stale
+    if (entry.first !=
+        current_distance + heuristic.Estimate(current, target)) {
+      continue;
     }
-    if (min_index == SIZE_T_MAX) {
-      break;
+    if (current == target) break;
+    graph.ForEachNeighbour(current, [&](const Graph::Neighbour &neighbour) {
+      size_t temp = current_distance + neighbour.weight;
+      if (temp < search.distance[neighbour.vertex]) {
+        search.Label(neighbour.vertex, temp, current,
+                     temp + heuristic.Estimate(neighbour.vertex, target));
+      }
+    });
+  }
+}
+
+ShortestPathCache *GraphAlgorithms::GetTreeCache(const Graph &graph) {
+  ShortestPathCache *cache = graph.GetShortestPathCache();
+  if (cache == nullptr || !cache->CanHold(graph.size())) return nullptr;
+  return cache;
+}
+
+std::shared_ptr<const ShortestPathCache::Tree>
+GraphAlgorithms::GetShortestPathTree(const Graph &graph, size_t source) {
+  ShortestPathCache &cache = *graph.GetShortestPathCache();
+  std::shared_ptr<const ShortestPathCache::Tree> tree = cache.Find(source);
+  if (tree == nullptr) {
+    thread_local DijkstraSearch search;
+    RunDijkstra(graph, source, kNoVertex, search);
+    tree = std::make_shared<const ShortestPathCache::Tree>(
+        ShortestPathCache::Tree{search.distance, search.predecessor});
+    cache.Insert(source, tree);
+  }
+  return tree;
+}
+
+GraphAlgorithms::PathResult GraphAlgorithms::GetSearchPath(
+    const std::vector<size_t> &distance,
+    const std::vector<size_t> &predecessor, size_t target) {
+  PathResult result{{}, distance[target]};
+  if (result.distance != SIZE_T_MAX) {
+    for (size_t v = target; v != kNoVertex; v = predecessor[v]) {
+      result.vertices.push_back(v);
     }
+    std::reverse(result.vertices.begin(), result.vertices.end());
+  }
+  return result;
+}
 
-    visited.at(min_index) = true;
-    for (size_t i = 0; i < size; i++) {
-      size_t edge_weight = graph.GetEdge(min_index, i);
-      if (edge_weight > 0) {
-        size_t temp = min_dist + edge_weight;
-        if (temp < distance.at(i)) {
-          distance.at(i) = temp;
-        }
+GraphAlgorithms::PathResult GraphAlgorithms::RunBidirectionalDijkstra(
+    const Graph &graph, size_t source, size_t target) {
+  thread_local DijkstraSearch forward;
+  thread_local DijkstraSearch backward;
+  forward.Reset(graph.size());
+  backward.Reset(graph.size());
+  forward.Label(source, 0, kNoVertex);
+  backward.Label(target, 0, kNoVertex);
+  size_t best = source == target ? 0 : SIZE_T_MAX;
+  size_t meeting = source == target ? source : kNoVertex;
+  // stops when no path through unsettled vertices can be shorter
+  while (!forward.heap.empty() && !backward.heap.empty() &&
+         forward.GetMinDistance() + backward.GetMinDistance() < best) {
+    bool is_forward = forward.heap.size() <= backward.heap.size();
+    DijkstraSearch &search = is_forward ? forward : backward;
+    DijkstraSearch &other = is_forward ? backward : forward;
+    size_t current = 0;
+    if (!search.PopSettled(current)) break;
+    size_t current_distance = search.distance[current];
+    auto relax = [&](const Graph::Neighbour &neighbour) {
+      size_t v = neighbour.vertex;
+      size_t temp = current_distance + neighbour.weight;
+      if (temp < search.distance[v]) search.Label(v, temp, current);
+      if (other.distance[v] != SIZE_T_MAX &&
+          search.distance[v] + other.distance[v] < best) {
+        best = search.distance[v] + other.distance[v];
+        meeting = v;
       }
+    };
+    if (is_forward) {
+      graph.ForEachNeighbour(current, relax);
+    } else {
+      graph.ForEachReverseNeighbour(current, relax);
     }
   }
-  return distance.at(vertex2);
+  PathResult result{{}, best};
+  if (meeting == kNoVertex) return result;
+  for (size_t v = meeting; v != kNoVertex; v = forward.predecessor[v]) {
+    result.vertices.push_back(v);
+  }
+  std::reverse(result.vertices.begin(), result.vertices.end());
+  for (size_t v = backward.predecessor[meeting]; v != kNoVertex;
+       v = backward.predecessor[v]) {
+    result.vertices.push_back(v);
+  }
+  return result;
 }
 
 Graph::AdjacencyMatrix GraphAlgorithms::GetShortestPathsBetweenAllVertices(
-    const Graph &graph) {
-  Graph::AdjacencyMatrix result_matrix(graph.GetMatrix());
+    const Graph &graph, AllPairsStrategy strategy, size_t num_threads) {
   size_t size = graph.size();
+  if (ChooseAllPairsStrategy(graph, strategy) == AllPairsStrategy::kDijkstra) {
+    Graph::AdjacencyMatrix result_matrix(size, size);
+    FillDijkstraRows(graph, 0, result_matrix, num_threads);
+    return result_matrix;
+  }
+  Graph::AdjacencyMatrix result_matrix(size, size, FloydWarshall::kInfinity);
+  for (size_t i = 0; i < size; i++) {
+    graph.ForEachNeighbour(i, [&](const Graph::Neighbour &neighbour) {
+      result_matrix(i, neighbour.vertex) = neighbour.weight;
+    });
+    // after the edges, so a self-loop does not hide the empty path
+    result_matrix(i, i) = 0;
+  }
+  FloydWarshall::Run(result_matrix, num_threads);
   for (size_t i = 0; i < size; i++) {
-    for (size_t j = 0; j < size; j++) {
-      if (graph.GetEdge(i, j) == 0 && i != j) {
-        result_matrix.at(i).at(j) = SIZE_T_MAX;
+    for (size_t &distance : result_matrix[i]) {
+      if (distance >= FloydWarshall::kInfinity) distance = SIZE_T_MAX;
+    }
+  }
+  return result_matrix;
+}
+
+void GraphAlgorithms::StreamShortestPathsBetweenAllVertices(
+    const Graph &graph, const RowBlockSink &sink, AllPairsStrategy strategy,
+    size_t num_threads, size_t block_rows) {
+  size_t size = graph.size();
+  // no rows to pass, and the block sizes below divide by the row count
+  if (size == 0) return;
+  size_t row_bytes = Graph::AdjacencyMatrix::GetStride(size) * sizeof(size_t);
+  if (block_rows == 0) {
+    block_rows = std::max<size_t>(1, kStreamBlockBytes / row_bytes);
+  }
+  block_rows = std::min(block_rows, size);
+  if (strategy == AllPairsStrategy::kAuto &&
+      row_bytes > graph.GetMemoryLimit() / size) {
+    strategy = AllPairsStrategy::kDijkstra;
+  }
+  if (ChooseAllPairsStrategy(graph, strategy) == AllPairsStrategy::kDijkstra) {
+    Graph::AdjacencyMatrix block(block_rows, size);
+    for (size_t first_row = 0; first_row < size; first_row += block_rows) {
+      if (size - first_row < block_rows) {
+        block = Graph::AdjacencyMatrix(size - first_row, size);
       }
+      FillDijkstraRows(graph, first_row, block, num_threads);
+      sink(first_row, block);
     }
+    return;
   }
-  for (size_t k = 0; k < size; k++) {
-    for (size_t i = 0; i < size; i++) {
-      for (size_t j = 0; j < size; j++) {
-        if (result_matrix.at(i).at(k) != SIZE_T_MAX &&
-            result_matrix.at(k).at(j) != SIZE_T_MAX &&
-            (result_matrix.at(i).at(j) >
-             result_matrix.at(i).at(k) + result_matrix.at(k).at(j))) {
-          result_matrix.at(i).at(j) =
-              result_matrix.at(i).at(k) + result_matrix.at(k).at(j);
+  Graph::AdjacencyMatrix distances = GetShortestPathsBetweenAllVertices(
+      graph, AllPairsStrategy::kFloydWarshall, num_threads);
+  Graph::AdjacencyMatrix block(block_rows, size);
+  for (size_t first_row = 0; first_row < size; first_row += block_rows) {
+    if (size - first_row < block_rows) {
+      block = Graph::AdjacencyMatrix(size - first_row, size);
+    }
+    for (size_t i = 0; i < block.GetRows(); ++i) {
+      std::copy(distances[first_row + i].begin(),
+                distances[first_row + i].end(), block[i].begin());
+    }
+    sink(first_row, block);
+  }
+}
+
+GraphAlgorithms::AllPairsStrategy GraphAlgorithms::ChooseAllPairsStrategy(
+    const Graph &graph, AllPairsStrategy strategy) {
+  if (strategy != AllPairsStrategy::kAuto) return strategy;
+  // V heap searches cost about V * E * log V against V^3 vectorised
+  // min-plus steps; the factor was measured on random 2000-vertex graphs
+  size_t size = graph.size();
+  size_t log_size = 1;
+  while ((size_t{1} << log_size) < size) ++log_size;
+  bool is_sparse =
+      graph.GetNumEdges() * log_size * kDijkstraCostFactor < size * size;
+  return is_sparse ? AllPairsStrategy::kDijkstra
+                   : AllPairsStrategy::kFloydWarshall;
+}
+
+void GraphAlgorithms::FillDijkstraRows(const Graph &graph, size_t first_row,
+                                       Graph::AdjacencyMatrix &rows,
+                                       size_t num_threads) {
+  ParallelFor(0, rows.GetRows(), num_threads, [&](size_t row) {
+    thread_local DijkstraSearch search;
+    RunDijkstra(graph, first_row + row, kNoVertex, search);
+    std::copy(search.distance.begin(), search.distance.end(),
+              rows[row].begin());
+  });
+}
+
+SignedGraph::DistanceMatrix GraphAlgorithms::GetShortestPathsBetweenAllVertices(
+    const SignedGraph &graph, size_t num_threads) {
+  size_t size = graph.size();
+  std::vector<SignedGraph::Weight> potential = GetPotentials(graph);
+  // w(u, v) + p(u) - p(v) >= 0 once the potentials are shortest distances
+  std::vector<size_t> offsets(1, 0);
+  std::vector<size_t> vertices;
+  std::vector<size_t> weights;
+  vertices.reserve(graph.GetNumEdges());
+  weights.reserve(graph.GetNumEdges());
+  for (size_t u = 0; u < size; ++u) {
+    for (const auto &neighbour : graph.GetNeighbours(u)) {
+      vertices.push_back(neighbour.vertex);
+      weights.push_back(neighbour.weight + potential[u] -
+                        potential[neighbour.vertex]);
+    }
+    offsets.push_back(vertices.size());
+  }
+  CsrStorage reduced(std::move(offsets), std::move(vertices),
+                     std::move(weights));
+  SignedGraph::DistanceMatrix result_matrix(size, size);
+  ParallelFor(0, size, num_threads, [&](size_t source) {
+    thread_local DijkstraSearch search;
+    search.Run(size, source, kNoVertex,
+               [&reduced](size_t v, auto function) {
+                 reduced.ForEachNeighbour(v, function);
+               });
+    SignedGraph::Weight *row = result_matrix[source].data();
+    for (size_t v = 0; v < size; ++v) {
+      size_t distance = search.distance[v];
+      row[v] = distance == SIZE_T_MAX
+                   ? SignedGraph::kUnreachable
+                   : static_cast<SignedGraph::Weight>(distance) -
+                         potential[source] + potential[v];
+    }
+  });
+  return result_matrix;
+}
+
+std::vector<SignedGraph::Weight> GraphAlgorithms::GetPotentials(
+    const SignedGraph &graph) {
+  size_t size = graph.size();
+  std::vector<SignedGraph::Weight> potential(size, 0);
+  std::vector<size_t> predecessor(size, kNoVertex);
+  // after the virtual arcs every shortest path has at most size - 1 arcs,
+  // so a change in round size means a negative cycle
+  size_t changed = kNoVertex;
+  for (size_t round = 0; round < size; ++round) {
+    changed = kNoVertex;
+    for (size_t u = 0; u < size; ++u) {
+      for (const auto &neighbour : graph.GetNeighbours(u)) {
+        if (potential[u] + neighbour.weight < potential[neighbour.vertex]) {
+          potential[neighbour.vertex] = potential[u] + neighbour.weight;
+          predecessor[neighbour.vertex] = u;
+          changed = neighbour.vertex;
         }
       }
     }
+    if (changed == kNoVertex) return potential;
   }
-  return result_matrix;
+  // size steps back along the predecessors always end on the cycle
+  for (size_t i = 0; i < size; ++i) changed = predecessor[changed];
+  std::vector<size_t> cycle{changed};
+  for (size_t v = predecessor[changed]; v != changed; v = predecessor[v]) {
+    cycle.push_back(v);
+  }
+  std::reverse(cycle.begin(), cycle.end());
+  throw NegativeCycleError(AddVertexStartNumber(cycle));
 }
 
 Graph::AdjacencyMatrix GraphAlgorithms::GetLeastSpanningTree(
-    const Graph &graph) {
-  Graph::AdjacencyMatrix result_matrix(graph.GetMatrix());
+    const Graph &graph, SpanningTreeStrategy strategy, size_t num_threads) {
+  return GetLeastSpanningTree(
+      graph.size(), GetMinimumSpanningTree(graph, strategy, num_threads));
+}
+
+Graph::AdjacencyMatrix GraphAlgorithms::GetLeastSpanningTree(
+    size_t size, const SpanningTreeResult &tree) {
+  Graph::AdjacencyMatrix result_matrix(size, size);
+  for (const Graph::Edge &edge : tree.edges) {
+    result_matrix(edge.from - kVertexStartNumber,
+                  edge.to - kVertexStartNumber) = edge.weight;
+    result_matrix(edge.to - kVertexStartNumber,
+                  edge.from - kVertexStartNumber) = edge.weight;
+  }
+  return result_matrix;
+}
+
+GraphAlgorithms::SpanningTreeResult GraphAlgorithms::GetMinimumSpanningTree(
+    const Graph &graph, SpanningTreeStrategy strategy, size_t num_threads) {
   if (!graph.GraphOrientationCheck()) {
     throw std::invalid_argument("Graph is not oriented");
   }
   size_t size = graph.size();
-  for (size_t i = 0; i < size; i++) {
-    for (size_t j = 0; j < size; j++) {
-      result_matrix.at(i).at(j) = 0;
+  std::vector<Graph::Edge> forest;
+  if (strategy == SpanningTreeStrategy::kPrim) {
+    forest = RunPrim(graph);
+  } else {
+    std::vector<Graph::Edge> edges;
+    edges.reserve(graph.GetNumEdges() / 2);
+    for (size_t i = 0; i < size; ++i) {
+      graph.ForEachNeighbour(i, [&](const Graph::Neighbour &neighbour) {
+        if (neighbour.vertex > i) {
+          edges.push_back({i, neighbour.vertex, neighbour.weight});
+        }
+      });
+    }
+    if (strategy == SpanningTreeStrategy::kAuto) {
+      bool parallel =
+          GetNumThreads(num_threads) >= kParallelSpanningTreeThreads &&
+          edges.size() >= kParallelSpanningTreeEdges;
+      strategy = parallel ? SpanningTreeStrategy::kBoruvka
+                          : SpanningTreeStrategy::kKruskal;
+    }
+    if (strategy == SpanningTreeStrategy::kKruskal) {
+      forest = RunKruskal(size, edges, num_threads);
+    } else {
+      for (size_t e : Boruvka::Run(size, edges, num_threads)) {
+        forest.push_back(edges[e]);
+      }
     }
   }
-  std::vector<bool> visited(size, false);
-  visited.at(0) = true;  // устанавливаем начальную точку построения дерева.
-  int unvisited = size - 1;
-  while (unvisited) {
-    size_t min_dist = SIZE_T_MAX;
-    size_t start = 0;
-    size_t end = 0;
-    for (size_t i = 0; i < size; i++) {
-      if (visited.at(i)) {
-        for (size_t j = 0; j < size; j++) {
-          if (j != i && !visited.at(j) && graph.GetEdge(i, j) != 0 &&
-              graph.GetMatrix().at(i).at(j) < min_dist) {
-            min_dist = graph.GetEdge(i, j);
-            start = i;
-            end = j;
-          }
-        }
+  if (strategy != SpanningTreeStrategy::kKruskal) {
+    std::sort(forest.begin(), forest.end(),
+              [](const Graph::Edge &a, const Graph::Edge &b) {
+                return std::tie(a.weight, a.from, a.to) <
+                       std::tie(b.weight, b.from, b.to);
+              });
+  }
+  // every forest edge joins two components
+  SpanningTreeResult result{{}, 0, size - forest.size()};
+  result.edges.reserve(forest.size());
+  for (const Graph::Edge &edge : forest) {
+    result.edges.push_back({edge.from + kVertexStartNumber,
+                            edge.to + kVertexStartNumber, edge.weight});
+    result.weight += edge.weight;
+  }
+  return result;
+}
+
+DynamicSpanningForest GraphAlgorithms::BuildDynamicSpanningForest(
+    const Graph &graph) {
+  return DynamicSpanningForest(graph, kVertexStartNumber);
+}
+
+std::vector<Graph::Edge> GraphAlgorithms::RunKruskal(
+    size_t size, std::vector<Graph::Edge> &edges, size_t num_threads) {
+  // stable, so ties keep the vertex order and the tree does not depend on
+  // the threads
+  SortEdgesByWeight(edges, num_threads);
+  std::vector<Graph::Edge> forest;
+  forest.reserve(size == 0 ? 0 : size - 1);
+  DisjointSet components(size);
+  for (const Graph::Edge &edge : edges) {
+    if (components.Unite(edge.from, edge.to)) {
+      forest.push_back(edge);
+      if (components.GetNumSets() == 1) break;
+    }
+  }
+  return forest;
+}
+
+std::vector<Graph::Edge> GraphAlgorithms::RunPrim(const Graph &graph) {
+  size_t size = graph.size();
+  std::vector<Graph::Edge> forest;
+  forest.reserve(size == 0 ? 0 : size - 1);
+  std::vector<bool> in_tree(size, false);
+  // distance is the weight of the lightest edge into the tree
+  DijkstraSearch search;
+  search.Reset(size);
+  for (size_t start = 0; start < size; ++start) {
+    if (in_tree[start]) continue;
+    search.Label(start, 0, kNoVertex);
+    size_t current = 0;
+    while (search.PopSettled(current)) {
+      if (in_tree[current]) continue;
+      in_tree[current] = true;
+      if (search.predecessor[current] != kNoVertex) {
+        forest.push_back({std::min(current, search.predecessor[current]),
+                          std::max(current, search.predecessor[current]),
+                          search.distance[current]});
       }
+      graph.ForEachNeighbour(current, [&](const Graph::Neighbour &neighbour) {
+        if (!in_tree[neighbour.vertex] &&
+            neighbour.weight < search.distance[neighbour.vertex]) {
+          search.Label(neighbour.vertex, neighbour.weight, current);
+        }
+      });
     }
-    result_matrix.at(start).at(end) = min_dist;
-    result_matrix.at(end).at(start) = min_dist;
-    visited.at(end) = true;
-    --unvisited;
   }
-  return result_matrix;
-};
+  return forest;
+}
 
 GraphAlgorithms::TsmResult GraphAlgorithms::SolveTravelingSalesmanProblem(
     const Graph &graph) {
-  AntColonyAlgorithm algorithm(graph);
+  AntColonyAlgorithm algorithm(graph, ant_local_search_);
   algorithm.RunAlgorithm();
   AntColonyAlgorithm::ResultTSP result = algorithm.GetResult();
 
@@ -198,21 +687,42 @@ GraphAlgorithms::TsmResult GraphAlgorithms::SolveTravelingSalesmanProblem(
           result.second};
 }
 
+GraphAlgorithms::TsmResult GraphAlgorithms::ImproveTour(
+    const Graph &graph, const TsmResult &tour) {
+  if (tour.vertices.empty()) return tour;
+  ResultArray vertices = ToInternalVertices(graph.size(), tour.vertices);
+  std::vector<char> visited(graph.size(), false);
+  for (size_t vertex : vertices) {
+    if (visited[vertex]) break;
+    visited[vertex] = true;
+  }
+  if (vertices.size() != graph.size() ||
+      std::find(visited.begin(), visited.end(), false) != visited.end()) {
+    throw std::invalid_argument("The tour does not visit every vertex once.");
+  }
+  size_t length = LocalSearch(graph).Improve(vertices);
+  return {AddVertexStartNumber(vertices),
+          length == LocalSearch::kInfinity
+              ? std::numeric_limits<double>::infinity()
+              : static_cast<double>(length)};
+}
+
 GraphAlgorithms::TsmResult GraphAlgorithms::DynamicProgrammingMethod(
     const s21::Graph &graph) {
-  TspState optimal_state{};
-  double upper_bound = std::numeric_limits<double>::max();
-
-  for (int vertex : graph.GetVertices()) {
-    FindOptimalPath(graph, {}, vertex, upper_bound, optimal_state);
+  if (HeldKarp::GetTableBytes(graph) <= graph.GetMemoryLimit()) {
+    HeldKarp::Tour tour = HeldKarp::Run(graph);
+    if (tour.distance == HeldKarp::kInfinity) {
+      return {{}, std::numeric_limits<double>::infinity()};
+    }
+    return {AddVertexStartNumber(tour.vertices),
+            static_cast<double>(tour.distance)};
   }
-  TsmResult optimal_result;
-  optimal_result.vertices = optimal_state.GetPath();
-
-  GraphAlgorithms::AddVertexStartNumber(optimal_result.vertices);
-
-  optimal_result.distance = optimal_state.GetCost();
-  return optimal_result;
+  BranchAndBound::Tour tour = BranchAndBound(graph).Run();
+  if (tour.distance == BranchAndBound::kInfinity) {
+    return {{}, std::numeric_limits<double>::infinity()};
+  }
+  return {AddVertexStartNumber(tour.vertices),
+          static_cast<double>(tour.distance)};
 }
 
 GraphAlgorithms::TsmResult GraphAlgorithms::MonteCarloMethod(
@@ -227,38 +737,4 @@ GraphAlgorithms::TsmResult GraphAlgorithms::MonteCarloMethod(
           result.second};
 }
 
-void GraphAlgorithms::FindOptimalPath(const s21::Graph &graph, TspState state,
-                                      size_t current_vertex,
-                                      double &upper_bound,
-                                      TspState &optimal_state) {
-  state.UpdatePath(current_vertex);
-  optimal_state.iteration_++;
-
-  if (state.path_.size() == graph.GetNumVertices()) {
-    double cost =
-        state.GetCost() + graph.GetEdge(current_vertex, state.path_[0]);
-    if (cost < upper_bound) {
-      state.UpdateCost(cost);
-      optimal_state = state;
-      upper_bound = cost;
-    }
-  } else {
-    if (state.cost_ < upper_bound)
-      for (int vertex : graph.GetVertices()) {
-        if (std::find(state.path_.begin(), state.path_.end(), vertex) ==
-            state.path_.end()) {
-          double cost = graph.GetEdge(current_vertex, vertex);
-
-          if (cost + state.cost_ < upper_bound) {
-            TspState nextState = state;
-            nextState.UpdateCost(cost + state.cost_);
-            FindOptimalPath(graph, nextState, vertex, upper_bound,
-                            optimal_state);
-          } else {
-            break;
-          }
-        }
-      }
-  }
-}
 }  // namespace s21
\ No newline at end of file
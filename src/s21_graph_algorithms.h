@@ -1,10 +1,18 @@
 #ifndef NAVIGATOR_S21_GRAPH_ALGORITHMS_H_
 #define NAVIGATOR_S21_GRAPH_ALGORITHMS_H_
 
+#include <functional>
 #include <iostream>
+#include <limits>
+#include <stdexcept>
 #include <vector>
 
+#include "contraction_hierarchy.h"
+#include "dynamic_spanning_forest.h"
+#include "landmark_heuristic.h"
+#include "path_heuristic.h"
 #include "s21_graph.h"
+#include "s21_signed_graph.h"
 
 /** Graph
  *! @brief Внутренняя нумерация вершин с 0!
@@ -12,50 +20,213 @@
  */
 namespace s21 {
 
+class DijkstraSearch;
+
+/** NegativeCycleError
+ *! @brief Thrown instead of distances when the graph has a cycle of
+ *! negative total weight; GetCycle() lists its vertices in order, numbered
+ *! from kVertexStartNumber, without repeating the first one.
+ */
+class NegativeCycleError : public std::domain_error {
+ public:
+  explicit NegativeCycleError(std::vector<size_t> cycle);
+  const std::vector<size_t> &GetCycle() const { return cycle_; }
+
+ private:
+  std::vector<size_t> cycle_;
+};
+
 class GraphAlgorithms {
  public:
   struct TsmResult {
     std::vector<size_t> vertices;
     double distance;
   };
+  // vertices from vertex1 to vertex2 inclusive, empty if unreachable
+  struct PathResult {
+    std::vector<size_t> vertices;
+    size_t distance;
+  };
+  // edges from smaller to larger vertex, numbered from kVertexStartNumber,
+  // by weight and then by vertices; a forest of num_components trees when
+  // the graph is disconnected, isolated vertices counted
+  struct SpanningTreeResult {
+    std::vector<Graph::Edge> edges;
+    size_t weight;
+    size_t num_components;
+  };
+  // kDijkstra searches from vertex1 only; kBidirectional also searches
+  // backwards from vertex2 and usually settles far fewer vertices. With
+  // Graph::SetShortestPathCache, kDijkstra keeps the whole tree of vertex1
+  // and answers later queries from it, unless one tree exceeds the cache.
+  enum class PathStrategy { kDijkstra, kBidirectional };
+  // kAuto runs Floyd-Warshall on dense graphs and one Dijkstra per source
+  // on sparse ones.
+  enum class AllPairsStrategy { kAuto, kFloydWarshall, kDijkstra };
+  // kKruskal radix-sorts the edges and joins them through a union-find;
+  // kBoruvka merges components in parallel rounds without sorting; kPrim
+  // grows the tree from one vertex with a binary heap. kAuto takes
+  // kBoruvka for large graphs when many threads are available.
+  enum class SpanningTreeStrategy { kAuto, kKruskal, kBoruvka, kPrim };
   static const size_t kVertexStartNumber = 1;
+  static const size_t kStreamBlockBytes = size_t{64} << 20;  // 64 MiB
+  static constexpr size_t kNoVertex = std::numeric_limits<size_t>::max();
   using ResultArray = std::vector<size_t>;
   using Result = size_t;
+  // receives rows [first_row, first_row + block.GetRows()) of a distance
+  // matrix
+  using RowBlockSink = std::function<void(
+      size_t first_row, const Graph::AdjacencyMatrix &block)>;
 
   // part 1
   static ResultArray BreadthFirstSearch(const Graph &graph, int start_vertex);
   static ResultArray DepthFirstSearch(const Graph &graph, int start_vertex);
   // part 2
-  static Result GetShortestPathBetweenVertices(const Graph &graph, int vertex1,
-                                               int vertex2);
+  static Result GetShortestPathBetweenVertices(
+      const Graph &graph, int vertex1, int vertex2,
+      PathStrategy strategy = PathStrategy::kDijkstra);
+  static PathResult GetShortestPath(
+      const Graph &graph, int vertex1, int vertex2,
+      PathStrategy strategy = PathStrategy::kDijkstra);
+  // Preprocessing for many queries on a static graph; the hierarchy can be
+  // saved next to the graph and loaded with ContractionHierarchy::Load.
+  static ContractionHierarchy BuildContractionHierarchy(const Graph &graph);
+  static Result GetShortestPathBetweenVertices(
+      const ContractionHierarchy &hierarchy, int vertex1, int vertex2);
+  static PathResult GetShortestPath(const ContractionHierarchy &hierarchy,
+                                    int vertex1, int vertex2);
+  // |sources| x |targets| table of distances, the maximum where there is
+  // no path. One search per source stops once every target is settled;
+  // sources are spread over num_threads (0 uses every hardware thread).
+  static Graph::AdjacencyMatrix GetDistanceTable(const Graph &graph,
+                                                 const ResultArray &sources,
+                                                 const ResultArray &targets,
+                                                 size_t num_threads = 0);
+  // Bucket-based many-to-many search on the hierarchy.
+  static Graph::AdjacencyMatrix GetDistanceTable(
+      const ContractionHierarchy &hierarchy, const ResultArray &sources,
+      const ResultArray &targets, size_t num_threads = 0);
+  // A* guided by an admissible lower bound: CoordinateHeuristic for graphs
+  // with node coordinates, LandmarkHeuristic (ALT) for any graph.
+  static LandmarkHeuristic BuildLandmarkHeuristic(
+      const Graph &graph,
+      size_t num_landmarks = LandmarkHeuristic::kDefaultNumLandmarks);
+  static Result GetShortestPathBetweenVertices(const Graph &graph,
+                                               int vertex1, int vertex2,
+                                               const PathHeuristic &heuristic);
+  static PathResult GetShortestPath(const Graph &graph, int vertex1,
+                                    int vertex2,
+                                    const PathHeuristic &heuristic);
+  // num_threads 0 uses every hardware thread
   static Graph::AdjacencyMatrix GetShortestPathsBetweenAllVertices(
-      const Graph &graph);
+      const Graph &graph, AllPairsStrategy strategy = AllPairsStrategy::kAuto,
+      size_t num_threads = 0);
+  // The same distances passed to sink block by block, in row order, so
+  // the whole matrix never has to be in memory: kDijkstra keeps only
+  // block_rows rows, kFloydWarshall builds the matrix first. kAuto also
+  // takes kDijkstra when the matrix exceeds the graph memory limit.
+  // block_rows 0 picks blocks of about kStreamBlockBytes.
+  static void StreamShortestPathsBetweenAllVertices(
+      const Graph &graph, const RowBlockSink &sink,
+      AllPairsStrategy strategy = AllPairsStrategy::kAuto,
+      size_t num_threads = 0, size_t block_rows = 0);
+  // Johnson: Bellman-Ford potentials make every weight non-negative, then
+  // one Dijkstra per source. kUnreachable marks pairs without a path;
+  // throws NegativeCycleError.
+  static SignedGraph::DistanceMatrix GetShortestPathsBetweenAllVertices(
+      const SignedGraph &graph, size_t num_threads = 0);
   // part 3
-  static Graph::AdjacencyMatrix GetLeastSpanningTree(const Graph &graph);
+  // The tree as an adjacency matrix, see GetMinimumSpanningTree.
+  static Graph::AdjacencyMatrix GetLeastSpanningTree(
+      const Graph &graph,
+      SpanningTreeStrategy strategy = SpanningTreeStrategy::kAuto,
+      size_t num_threads = 0);
+  static Graph::AdjacencyMatrix GetLeastSpanningTree(
+      size_t size, const SpanningTreeResult &tree);
+  // Minimum spanning forest of every component in one pass.
+  // Undirected graphs only. Kruskal and Boruvka order equal weights by
+  // vertices and return the same tree; Prim may pick another one of the
+  // same weight. num_threads 0 uses every hardware thread.
+  static SpanningTreeResult GetMinimumSpanningTree(
+      const Graph &graph,
+      SpanningTreeStrategy strategy = SpanningTreeStrategy::kAuto,
+      size_t num_threads = 0);
+  // For graphs whose edges keep changing: the forest is updated edge by
+  // edge instead of being recomputed. Vertices numbered from
+  // kVertexStartNumber.
+  static DynamicSpanningForest BuildDynamicSpanningForest(const Graph &graph);
   // part 4
+  // Ant colony; its matrices cover every vertex pair, so it throws
+  // std::invalid_argument where they exceed the graph memory limit.
   TsmResult SolveTravelingSalesmanProblem(const Graph &graph);
+  // Local search on the best ant of every iteration of the ant colony,
+  // off by default.
+  void SetAntLocalSearch(bool enabled) { ant_local_search_ = enabled; }
+  // 2-opt and Or-opt moves on a tour from any method, which keeps its first
+  // vertex; throws std::invalid_argument unless it visits every vertex
+  // once. A tour without vertices is returned as it is.
+  static TsmResult ImproveTour(const Graph &graph, const TsmResult &tour);
   // part 6
+  // Held-Karp while its table fits in the graph memory limit (about 25
+  // vertices), the lexicographically smallest shortest tour from vertex 1;
+  // branch and bound beyond, any shortest tour. No vertices and an
+  // infinite distance if there is none. Throws std::invalid_argument when
+  // the branch and bound matrices exceed the limit too.
   TsmResult DynamicProgrammingMethod(const Graph &graph);
   TsmResult MonteCarloMethod(const Graph &graph);
 
  private:
-  class TspState {
-   public:
-    double GetCost() { return cost_; }
-    // Получение текущего пути и стоимости
-    ResultArray GetPath() { return std::vector(path_.begin(), path_.end()); }
-    // Обновление состояния решения
-    void UpdateCost(double cost) { this->cost_ = cost; }
-    void UpdatePath(size_t vertex) { path_.push_back(vertex); }
-
-    std::vector<size_t> path_;
-    double cost_ = 0;
-    size_t iteration_ = 0;
-  };
+  // relative cost of a Dijkstra edge relaxation and a min-plus step
+  static const size_t kDijkstraCostFactor = 48;
   static ResultArray &AddVertexStartNumber(ResultArray &array);
-  void FindOptimalPath(const s21::Graph &graph, TspState state,
-                       size_t currentVertex, double &upperBound,
-                       TspState &optimalState);
+  static void CheckVertex(size_t num_vertices, int vertex);
+  // checked copy with internal vertex numbers
+  static ResultArray ToInternalVertices(size_t num_vertices,
+                                        const ResultArray &vertices);
+  // Binary-heap Dijkstra from source, stops once target is settled
+  // (kNoVertex runs to completion). Unreached vertices keep the maximum
+  // distance and kNoVertex as predecessor.
+  static void RunDijkstra(const Graph &graph, size_t source, size_t target,
+                          DijkstraSearch &search);
+  // A* from source to target; works on every representation.
+  static void RunAStar(const Graph &graph, size_t source, size_t target,
+                       const PathHeuristic &heuristic,
+                       DijkstraSearch &search);
+  // kAuto takes Boruvka from this many threads and undirected edges; one
+  // thread of it is about three times slower than Kruskal
+  static const size_t kParallelSpanningTreeThreads = 8;
+  static const size_t kParallelSpanningTreeEdges = size_t{1} << 16;
+  static AllPairsStrategy ChooseAllPairsStrategy(const Graph &graph,
+                                                 AllPairsStrategy strategy);
+  // distances from sources first_row, first_row + 1, ... into rows
+  static void FillDijkstraRows(const Graph &graph, size_t first_row,
+                               Graph::AdjacencyMatrix &rows,
+                               size_t num_threads);
+  // forest edges with internal vertex numbers, in the order they were found
+  static std::vector<Graph::Edge> RunKruskal(size_t size,
+                                             std::vector<Graph::Edge> &edges,
+                                             size_t num_threads);
+  static std::vector<Graph::Edge> RunPrim(const Graph &graph);
+  // Bellman-Ford from a virtual source joined to every vertex by 0-weight
+  // arcs; throws NegativeCycleError.
+  static std::vector<SignedGraph::Weight> GetPotentials(
+      const SignedGraph &graph);
+  // the graph's ShortestPathCache, nullptr if it is disabled or cannot
+  // hold a single tree, so queries keep stopping at their target
+  static ShortestPathCache *GetTreeCache(const Graph &graph);
+  // complete search tree of source from the graph's ShortestPathCache,
+  // computed and cached on a miss
+  static std::shared_ptr<const ShortestPathCache::Tree> GetShortestPathTree(
+      const Graph &graph, size_t source);
+  // route to target from a finished search, internal vertex numbers
+  static PathResult GetSearchPath(const std::vector<size_t> &distance,
+                                  const std::vector<size_t> &predecessor,
+                                  size_t target);
+  // Returns the route with internal vertex numbers.
+  static PathResult RunBidirectionalDijkstra(const Graph &graph,
+                                             size_t source, size_t target);
+
+  bool ant_local_search_ = false;
 };
 
 }  // namespace s21
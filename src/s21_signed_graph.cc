@@ -0,0 +1,62 @@
+#include "s21_signed_graph.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <tuple>
+
+#include "text_graph_parser.h"
+
+namespace s21 {
+
+SignedGraph::SignedGraph(size_t size, std::vector<Edge> edges)
+    : offsets_(size + 1, 0) {
+  for (const Edge &edge : edges) {
+    if (edge.from >= size || edge.to >= size) {
+      throw std::out_of_range("Vertex out of range");
+    }
+  }
+  std::sort(edges.begin(), edges.end(), [](const Edge &a, const Edge &b) {
+    return std::tie(a.from, a.to, a.weight) < std::tie(b.from, b.to, b.weight);
+  });
+  neighbours_.reserve(edges.size());
+  for (size_t i = 0; i < edges.size(); ++i) {
+    // the lightest of parallel arcs comes first
+    if (i > 0 && edges[i].from == edges[i - 1].from &&
+        edges[i].to == edges[i - 1].to) {
+      continue;
+    }
+    neighbours_.push_back({edges[i].to, edges[i].weight});
+    ++offsets_[edges[i].from + 1];
+  }
+  for (size_t v = 0; v < size; ++v) offsets_[v + 1] += offsets_[v];
+}
+
+SignedGraph::SignedGraph(const Graph &graph) : offsets_(1, 0) {
+  for (size_t v = 0; v < graph.size(); ++v) {
+    graph.ForEachNeighbour(v, [this](const Graph::Neighbour &neighbour) {
+      neighbours_.push_back(
+          {neighbour.vertex, static_cast<Weight>(neighbour.weight)});
+    });
+    offsets_.push_back(neighbours_.size());
+  }
+}
+
+void SignedGraph::LoadGraphFromFile(const std::string &filename) {
+  TextGraphParser parser(filename);
+  std::vector<Edge> edges;
+  size_t size = 0;
+  size_t from = 0;
+  size_t to = 0;
+  Weight weight = 0;
+  while (parser.ReadSignedEdge(from, to, weight)) {
+    edges.push_back({from - 1, to - 1, weight});
+    size = std::max(size, std::max(from, to));
+  }
+  if (size < Graph::kMinSize) {
+    throw std::invalid_argument(
+        "File read error. The dimensions are not correct.");
+  }
+  *this = SignedGraph(size, std::move(edges));
+}
+
+}  // namespace s21
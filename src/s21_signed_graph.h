@@ -0,0 +1,75 @@
+#ifndef NAVIGATOR_S21_SIGNED_GRAPH_H_
+#define NAVIGATOR_S21_SIGNED_GRAPH_H_
+
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "matrix.h"
+#include "s21_graph.h"
+
+namespace s21 {
+
+/** SignedGraph
+ *! @brief Directed graph with signed integer weights for algorithms that
+ *! accept negative edges. Adjacency lists only, sorted by vertex; unlike
+ *! Graph, a listed edge of weight 0 is an edge. Internal numbering from 0.
+ */
+class SignedGraph {
+ public:
+  using Weight = int64_t;
+  using DistanceMatrix = BasicMatrix<Weight>;
+
+  struct Neighbour {
+    size_t vertex;
+    Weight weight;
+  };
+
+  struct Edge {
+    size_t from;
+    size_t to;
+    Weight weight;
+  };
+
+  class NeighbourRange {
+   public:
+    NeighbourRange(const Neighbour *begin, const Neighbour *end)
+        : begin_(begin), end_(end) {}
+
+    const Neighbour *begin() const { return begin_; }
+    const Neighbour *end() const { return end_; }
+    size_t size() const { return end_ - begin_; }
+
+   private:
+    const Neighbour *begin_;
+    const Neighbour *end_;
+  };
+
+  // distance between vertices with no path
+  static constexpr Weight kUnreachable = std::numeric_limits<Weight>::max();
+
+  SignedGraph() : offsets_(1, 0) {}
+  // Arcs in any order; parallel arcs keep the lightest weight.
+  SignedGraph(size_t size, std::vector<Edge> edges);
+  // Same arcs as graph.
+  explicit SignedGraph(const Graph &graph);
+
+  size_t size() const { return offsets_.size() - 1; }
+  size_t GetNumEdges() const { return neighbours_.size(); }
+  NeighbourRange GetNeighbours(size_t vertex) const {
+    return {neighbours_.data() + offsets_.at(vertex),
+            neighbours_.data() + offsets_.at(vertex + 1)};
+  }
+  // "from to [weight]" per line like Graph::LoadGraphFromEdgeListFile, but
+  // weights may be negative or zero.
+  void LoadGraphFromFile(const std::string &filename);
+
+ private:
+  std::vector<size_t> offsets_;
+  std::vector<Neighbour> neighbours_;
+};
+
+}  // namespace s21
+
+#endif  // NAVIGATOR_S21_SIGNED_GRAPH_H_
@@ -0,0 +1,459 @@
+#include "contraction_hierarchy.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <queue>
+#include <stdexcept>
+#include <tuple>
+
+#include "dijkstra_search.h"
+#include "parallel_for.h"
+
+namespace s21 {
+
+namespace {
+
+const uint32_t kByteOrder = 0x01020304;
+
+struct Arc {
+  size_t vertex;
+  size_t weight;
+  size_t middle;
+};
+
+/** Contractor
+ *! @brief Contraction state: all arcs found so far (never removed, the
+ *! contracted flags hide them) and local witness searches.
+ */
+class Contractor {
+ public:
+  // witness searches give up after this many settled vertices; a missed
+  // witness only costs an unnecessary shortcut
+  static const size_t kMaxSettled = 500;
+
+  explicit Contractor(const Graph &graph)
+      : out_(graph.size()),
+        in_(graph.size()),
+        contracted_(graph.size(), false),
+        contracted_neighbours_(graph.size(), 0) {
+    for (size_t u = 0; u < graph.size(); ++u) {
+      graph.ForEachNeighbour(u, [&](const Graph::Neighbour &neighbour) {
+        if (neighbour.vertex == u) return;
+        out_[u].push_back({neighbour.vertex, neighbour.weight, kNone});
+        in_[neighbour.vertex].push_back({u, neighbour.weight, kNone});
+      });
+    }
+  }
+
+  // Contracts every vertex and returns the contraction order ranks.
+  std::vector<size_t> Run(size_t &num_shortcuts) {
+    using Entry = std::pair<long long, size_t>;  // priority, vertex
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> queue;
+    for (size_t v = 0; v < out_.size(); ++v) queue.push({GetPriority(v), v});
+    std::vector<size_t> rank(out_.size(), 0);
+    size_t next_rank = 0;
+    num_shortcuts = 0;
+    while (!queue.empty()) {
+      size_t v = queue.top().second;
+      queue.pop();
+      if (contracted_[v]) continue;
+      // lazy update: priorities change as neighbours get contracted
+      long long priority = GetPriority(v);
+      if (!queue.empty() && priority > queue.top().first) {
+        queue.push({priority, v});
+        continue;
+      }
+      num_shortcuts += Contract(v, true);
+      contracted_[v] = true;
+      rank[v] = next_rank++;
+      for (const auto *arcs : {&out_[v], &in_[v]}) {
+        for (const Arc &arc : *arcs) ++contracted_neighbours_[arc.vertex];
+      }
+    }
+    return rank;
+  }
+
+  const std::vector<std::vector<Arc>> &GetArcs() const { return out_; }
+
+ private:
+  static constexpr size_t kNone = ContractionHierarchy::kInfinity;
+
+  long long GetPriority(size_t v) {
+    long long removed = 0;
+    for (const auto *arcs : {&out_[v], &in_[v]}) {
+      for (const Arc &arc : *arcs) removed += !contracted_[arc.vertex];
+    }
+    long long shortcuts = static_cast<long long>(Contract(v, false));
+    return shortcuts - removed + contracted_neighbours_[v];
+  }
+
+  // Number of shortcuts replacing v, added to the arcs if apply is set.
+  size_t Contract(size_t v, bool apply) {
+    size_t max_out = 0;
+    for (const Arc &arc : out_[v]) {
+      if (!contracted_[arc.vertex]) max_out = std::max(max_out, arc.weight);
+    }
+    size_t shortcuts = 0;
+    for (size_t i = 0; i < in_[v].size(); ++i) {
+      Arc in = in_[v][i];
+      if (contracted_[in.vertex]) continue;
+      FindWitnesses(in.vertex, v, in.weight + max_out);
+      for (size_t j = 0; j < out_[v].size(); ++j) {
+        Arc out = out_[v][j];
+        if (contracted_[out.vertex] || out.vertex == in.vertex) continue;
+        size_t weight = in.weight + out.weight;
+        if (witness_.distance[out.vertex] <= weight) continue;
+        ++shortcuts;
+        if (apply) AddArc(in.vertex, out.vertex, weight, v);
+      }
+    }
+    return shortcuts;
+  }
+
+  // Dijkstra from source avoiding excluded and contracted vertices.
+  void FindWitnesses(size_t source, size_t excluded, size_t limit) {
+    witness_.Reset(out_.size());
+    witness_.Label(source, 0, kNone);
+    size_t current = 0;
+    for (size_t settled = 0; settled < kMaxSettled; ++settled) {
+      if (!witness_.PopSettled(current)) break;
+      size_t distance = witness_.distance[current];
+      if (distance > limit) break;
+      for (const Arc &arc : out_[current]) {
+        if (arc.vertex == excluded || contracted_[arc.vertex]) continue;
+        if (distance + arc.weight < witness_.distance[arc.vertex]) {
+          witness_.Label(arc.vertex, distance + arc.weight, current);
+        }
+      }
+    }
+  }
+
+  void AddArc(size_t from, size_t to, size_t weight, size_t middle) {
+    auto same = [](size_t vertex) {
+      return [vertex](const Arc &arc) { return arc.vertex == vertex; };
+    };
+    auto out = std::find_if(out_[from].begin(), out_[from].end(), same(to));
+    if (out == out_[from].end()) {
+      out_[from].push_back({to, weight, middle});
+      in_[to].push_back({from, weight, middle});
+      return;
+    }
+    if (weight >= out->weight) return;
+    auto in = std::find_if(in_[to].begin(), in_[to].end(), same(from));
+    *out = {to, weight, middle};
+    *in = {from, weight, middle};
+  }
+
+  std::vector<std::vector<Arc>> out_;
+  std::vector<std::vector<Arc>> in_;
+  std::vector<bool> contracted_;
+  std::vector<long long> contracted_neighbours_;
+  DijkstraSearch witness_;
+};
+
+// Rows sorted by vertex, middles kept aligned with the CSR edge order.
+std::shared_ptr<const CsrStorage> BuildRows(
+    std::vector<std::vector<Arc>> &rows, std::vector<size_t> &middles) {
+  std::vector<size_t> offsets(1, 0);
+  std::vector<size_t> vertices;
+  std::vector<size_t> weights;
+  middles.clear();
+  for (auto &row : rows) {
+    std::sort(row.begin(), row.end(), [](const Arc &a, const Arc &b) {
+      return a.vertex < b.vertex;
+    });
+    for (const Arc &arc : row) {
+      vertices.push_back(arc.vertex);
+      weights.push_back(arc.weight);
+      middles.push_back(arc.middle);
+    }
+    offsets.push_back(vertices.size());
+  }
+  return std::make_shared<const CsrStorage>(
+      std::move(offsets), std::move(vertices), std::move(weights));
+}
+
+}  // namespace
+
+ContractionHierarchy::ContractionHierarchy()
+    : up_(std::make_shared<CsrStorage>()),
+      down_(std::make_shared<CsrStorage>()) {}
+
+ContractionHierarchy::ContractionHierarchy(const Graph &graph) {
+  Contractor contractor(graph);
+  rank_ = contractor.Run(num_shortcuts_);
+  std::vector<std::vector<Arc>> up(graph.size());
+  std::vector<std::vector<Arc>> down(graph.size());
+  const auto &arcs = contractor.GetArcs();
+  for (size_t u = 0; u < arcs.size(); ++u) {
+    for (const Arc &arc : arcs[u]) {
+      if (rank_[arc.vertex] > rank_[u]) {
+        up[u].push_back(arc);
+      } else {
+        down[arc.vertex].push_back({u, arc.weight, arc.middle});
+      }
+    }
+  }
+  up_ = BuildRows(up, up_middles_);
+  down_ = BuildRows(down, down_middles_);
+}
+
+size_t ContractionHierarchy::GetDistance(size_t source, size_t target) const {
+  CheckVertex(source);
+  CheckVertex(target);
+  return Search(source, target, nullptr);
+}
+
+BasicMatrix<size_t> ContractionHierarchy::GetDistanceTable(
+    const std::vector<size_t> &sources, const std::vector<size_t> &targets,
+    size_t num_threads) const {
+  for (size_t vertex : sources) CheckVertex(vertex);
+  for (size_t vertex : targets) CheckVertex(vertex);
+  struct BucketEntry {
+    size_t target;
+    size_t distance;
+  };
+  const size_t size = GetNumVertices();
+  // (vertex, entry) of every vertex reached from each target
+  std::vector<std::vector<std::pair<size_t, BucketEntry>>> reached(
+      targets.size());
+  ParallelFor(0, targets.size(), num_threads, [&](size_t j) {
+    thread_local DijkstraSearch search;
+    search.Run(size, targets[j], kInfinity,
+               [this](size_t v, auto function) {
+                 down_->ForEachNeighbour(v, function);
+               });
+    reached[j].reserve(search.labelled.size());
+    for (size_t v : search.labelled) {
+      reached[j].push_back({v, {j, search.distance[v]}});
+    }
+  });
+  // buckets in CSR form, filled by counting sort on the vertex
+  std::vector<size_t> offsets(size + 1, 0);
+  for (const auto &entries : reached) {
+    for (const auto &entry : entries) ++offsets[entry.first + 1];
+  }
+  for (size_t v = 0; v < size; ++v) offsets[v + 1] += offsets[v];
+  std::vector<BucketEntry> buckets(offsets[size]);
+  std::vector<size_t> next(offsets.begin(), offsets.end() - 1);
+  for (auto &entries : reached) {
+    for (const auto &entry : entries) {
+      buckets[next[entry.first]++] = entry.second;
+    }
+    std::vector<std::pair<size_t, BucketEntry>>().swap(entries);
+  }
+  BasicMatrix<size_t> table(sources.size(), targets.size(), kInfinity);
+  ParallelFor(0, sources.size(), num_threads, [&](size_t i) {
+    thread_local DijkstraSearch search;
+    search.Run(size, sources[i], kInfinity,
+               [this](size_t v, auto function) {
+                 up_->ForEachNeighbour(v, function);
+               });
+    size_t *row = table[i].data();
+    for (size_t v : search.labelled) {
+      size_t distance = search.distance[v];
+      for (size_t k = offsets[v]; k < offsets[v + 1]; ++k) {
+        row[buckets[k].target] =
+            std::min(row[buckets[k].target], distance + buckets[k].distance);
+      }
+    }
+  });
+  return table;
+}
+
+std::vector<size_t> ContractionHierarchy::GetPath(size_t source,
+                                                  size_t target,
+                                                  size_t *distance) const {
+  CheckVertex(source);
+  CheckVertex(target);
+  std::vector<size_t> packed_path;
+  size_t length = Search(source, target, &packed_path);
+  if (distance != nullptr) *distance = length;
+  if (length == kInfinity) return {};
+  std::vector<size_t> path{source};
+  for (size_t i = 0; i + 1 < packed_path.size(); ++i) {
+    Unpack(packed_path[i], packed_path[i + 1], path);
+  }
+  return path;
+}
+
+size_t ContractionHierarchy::Search(size_t source, size_t target,
+                                    std::vector<size_t> *packed_path) const {
+  thread_local DijkstraSearch forward;
+  thread_local DijkstraSearch backward;
+  forward.Reset(GetNumVertices());
+  backward.Reset(GetNumVertices());
+  forward.Label(source, 0, kInfinity);
+  backward.Label(target, 0, kInfinity);
+  size_t best = kInfinity;
+  size_t meeting = kInfinity;
+  bool forward_active = true;
+  bool backward_active = true;
+  while (forward_active || backward_active) {
+    bool is_forward =
+        forward_active && (!backward_active || forward.GetMinDistance() <=
+                                                   backward.GetMinDistance());
+    DijkstraSearch &search = is_forward ? forward : backward;
+    DijkstraSearch &other = is_forward ? backward : forward;
+    size_t current = 0;
+    // each direction stops once it cannot improve the best meeting
+    if (search.GetMinDistance() >= best || !search.PopSettled(current)) {
+      (is_forward ? forward_active : backward_active) = false;
+      continue;
+    }
+    size_t distance = search.distance[current];
+    if (other.distance[current] != kInfinity &&
+        distance + other.distance[current] < best) {
+      best = distance + other.distance[current];
+      meeting = current;
+    }
+    const CsrStorage &arcs = is_forward ? *up_ : *down_;
+    for (const auto &arc : arcs.GetNeighbours(current)) {
+      if (distance + arc.weight < search.distance[arc.vertex]) {
+        search.Label(arc.vertex, distance + arc.weight, current);
+      }
+    }
+  }
+  if (packed_path != nullptr && best != kInfinity) {
+    for (size_t v = meeting; v != kInfinity; v = forward.predecessor[v]) {
+      packed_path->push_back(v);
+    }
+    std::reverse(packed_path->begin(), packed_path->end());
+    for (size_t v = backward.predecessor[meeting]; v != kInfinity;
+         v = backward.predecessor[v]) {
+      packed_path->push_back(v);
+    }
+  }
+  return best;
+}
+
+size_t ContractionHierarchy::GetMiddle(size_t from, size_t to) const {
+  bool upward = rank_[to] > rank_[from];
+  const CsrStorage &arcs = upward ? *up_ : *down_;
+  size_t row = upward ? from : to;
+  size_t vertex = upward ? to : from;
+  const size_t *first = arcs.GetVertices() + arcs.GetOffsets()[row];
+  const size_t *last = arcs.GetVertices() + arcs.GetOffsets()[row + 1];
+  const size_t *it = std::lower_bound(first, last, vertex);
+  if (it == last || *it != vertex) {
+    throw std::logic_error("Contraction hierarchy arc is missing");
+  }
+  size_t index = it - arcs.GetVertices();
+  return upward ? up_middles_[index] : down_middles_[index];
+}
+
+void ContractionHierarchy::Unpack(size_t from, size_t to,
+                                  std::vector<size_t> &path) const {
+  // depth-first over shortcuts, the right half waits on the stack
+  std::vector<std::pair<size_t, size_t>> stack{{from, to}};
+  while (!stack.empty()) {
+    auto [a, b] = stack.back();
+    stack.pop_back();
+    size_t middle = GetMiddle(a, b);
+    if (middle == kInfinity) {
+      path.push_back(b);
+    } else {
+      stack.push_back({middle, b});
+      stack.push_back({a, middle});
+    }
+  }
+}
+
+void ContractionHierarchy::CheckVertex(size_t vertex) const {
+  if (vertex >= GetNumVertices()) {
+    throw std::out_of_range("Vertex out of range");
+  }
+}
+
+void ContractionHierarchy::Save(const std::string &filename) const {
+  if (filename.empty()) throw std::invalid_argument("Empty filename");
+  Header header{};
+  std::memcpy(header.magic, kMagic, sizeof(kMagic));
+  header.version = kVersion;
+  header.byte_order = kByteOrder;
+  header.num_vertices = GetNumVertices();
+  header.num_up_edges = up_->GetNumEdges();
+  header.num_down_edges = down_->GetNumEdges();
+  header.num_shortcuts = num_shortcuts_;
+  std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+  if (!file) throw std::invalid_argument("File write error.");
+  auto write_array = [&file](const size_t *data, size_t size) {
+    file.write(reinterpret_cast<const char *>(data), size * sizeof(size_t));
+  };
+  file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+  write_array(rank_.data(), rank_.size());
+  for (const auto &[arcs, middles] :
+       {std::tie(up_, up_middles_), std::tie(down_, down_middles_)}) {
+    write_array(arcs->GetOffsets(), arcs->GetNumVertices() + 1);
+    write_array(arcs->GetVertices(), arcs->GetNumEdges());
+    write_array(arcs->GetWeights(), arcs->GetNumEdges());
+    write_array(middles.data(), middles.size());
+  }
+  if (!file) throw std::invalid_argument("File write error.");
+}
+
+ContractionHierarchy ContractionHierarchy::Load(const std::string &filename) {
+  std::ifstream file(filename, std::ios::binary);
+  if (!file) {
+    throw std::invalid_argument("File read error. The file is missing.");
+  }
+  Header header{};
+  file.read(reinterpret_cast<char *>(&header), sizeof(header));
+  if (!file || std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0) {
+    throw std::invalid_argument(
+        "File read error. Not a contraction hierarchy file.");
+  }
+  if (header.version != kVersion || header.byte_order != kByteOrder) {
+    throw std::invalid_argument(
+        "File read error. Unsupported contraction hierarchy version.");
+  }
+  file.seekg(0, std::ios::end);
+  uint64_t available = static_cast<uint64_t>(file.tellg()) - sizeof(header);
+  file.seekg(sizeof(header));
+  uint64_t vertices = header.num_vertices;
+  uint64_t max_elements = available / sizeof(size_t);
+  if (vertices >= max_elements || header.num_up_edges > max_elements ||
+      header.num_down_edges > max_elements ||
+      available != (3 * vertices + 2 + 3 * header.num_up_edges +
+                    3 * header.num_down_edges) *
+                       sizeof(size_t)) {
+    throw std::invalid_argument(
+        "File read error. The contraction hierarchy is truncated.");
+  }
+  auto read_array = [&file](size_t size) {
+    std::vector<size_t> array(size);
+    file.read(reinterpret_cast<char *>(array.data()), size * sizeof(size_t));
+    return array;
+  };
+  auto read_arcs = [&](size_t edges, std::vector<size_t> &middles) {
+    std::vector<size_t> offsets = read_array(vertices + 1);
+    std::vector<size_t> targets = read_array(edges);
+    std::vector<size_t> weights = read_array(edges);
+    middles = read_array(edges);
+    bool valid = offsets.front() == 0 && offsets.back() == edges &&
+                 std::is_sorted(offsets.begin(), offsets.end());
+    for (size_t i = 0; valid && i < edges; ++i) {
+      valid = targets[i] < vertices &&
+              (middles[i] < vertices || middles[i] == kInfinity);
+    }
+    if (!valid) {
+      throw std::invalid_argument(
+          "File read error. The contraction hierarchy is corrupted.");
+    }
+    return std::make_shared<const CsrStorage>(
+        std::move(offsets), std::move(targets), std::move(weights));
+  };
+  ContractionHierarchy hierarchy;
+  hierarchy.rank_ = read_array(vertices);
+  hierarchy.up_ = read_arcs(header.num_up_edges, hierarchy.up_middles_);
+  hierarchy.down_ = read_arcs(header.num_down_edges, hierarchy.down_middles_);
+  hierarchy.num_shortcuts_ = header.num_shortcuts;
+  if (!file) {
+    throw std::invalid_argument(
+        "File read error. The contraction hierarchy is truncated.");
+  }
+  return hierarchy;
+}
+
+}  // namespace s21
@@ -0,0 +1,83 @@
+#ifndef NAVIGATOR_SHORTEST_PATH_CONTRACTION_HIERARCHY_H_
+#define NAVIGATOR_SHORTEST_PATH_CONTRACTION_HIERARCHY_H_
+
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "csr_storage.h"
+#include "s21_graph.h"
+
+namespace s21 {
+
+/** ContractionHierarchy
+ *! @brief Preprocessed graph for fast point-to-point queries. Vertices are
+ *! contracted in edge-difference order and shortcuts keep the distances
+ *! between the remaining ones; a query is a bidirectional Dijkstra that
+ *! only moves to higher-ranked vertices. Internal vertex numbering.
+ */
+class ContractionHierarchy {
+ public:
+  static constexpr size_t kInfinity = std::numeric_limits<size_t>::max();
+  static constexpr char kMagic[8] = {'S', '2', '1', 'C', 'H', 'I', 'E', 'R'};
+  static const uint32_t kVersion = 1;
+
+  ContractionHierarchy();
+  explicit ContractionHierarchy(const Graph &graph);
+
+  size_t GetNumVertices() const { return rank_.size(); }
+  size_t GetNumShortcuts() const { return num_shortcuts_; }
+  size_t GetRank(size_t vertex) const { return rank_.at(vertex); }
+
+  // kInfinity if target is unreachable
+  size_t GetDistance(size_t source, size_t target) const;
+  // vertices from source to target inclusive, empty if unreachable;
+  // the path length goes to distance if it is not null
+  std::vector<size_t> GetPath(size_t source, size_t target,
+                              size_t *distance = nullptr) const;
+
+  // Many-to-many distances, one row per source: one backward search per
+  // target fills buckets at the vertices it reaches, and one forward search
+  // per source scans the buckets it meets. Searches run on num_threads
+  // threads (0 uses every hardware thread).
+  BasicMatrix<size_t> GetDistanceTable(const std::vector<size_t> &sources,
+                                       const std::vector<size_t> &targets,
+                                       size_t num_threads = 1) const;
+
+  void Save(const std::string &filename) const;
+  static ContractionHierarchy Load(const std::string &filename);
+
+ private:
+  struct Header {
+    char magic[8];
+    uint32_t version;
+    uint32_t byte_order;
+    uint64_t num_vertices;
+    uint64_t num_up_edges;
+    uint64_t num_down_edges;
+    uint64_t num_shortcuts;
+  };
+
+  // fills the path over hierarchy arcs if packed_path is not null
+  size_t Search(size_t source, size_t target,
+                std::vector<size_t> *packed_path) const;
+  // contracted vertex of the arc from -> to, or kInfinity for an edge
+  size_t GetMiddle(size_t from, size_t to) const;
+  void Unpack(size_t from, size_t to, std::vector<size_t> &path) const;
+  void CheckVertex(size_t vertex) const;
+
+  std::vector<size_t> rank_;
+  // up_: arcs u -> v with rank[v] > rank[u], stored at u;
+  // down_: arcs u -> v with rank[u] > rank[v], stored at v as u.
+  std::shared_ptr<const CsrStorage> up_;
+  std::shared_ptr<const CsrStorage> down_;
+  std::vector<size_t> up_middles_;
+  std::vector<size_t> down_middles_;
+  size_t num_shortcuts_ = 0;
+};
+
+}  // namespace s21
+
+#endif  // NAVIGATOR_SHORTEST_PATH_CONTRACTION_HIERARCHY_H_
@@ -0,0 +1,97 @@
+#ifndef NAVIGATOR_SHORTEST_PATH_DIJKSTRA_SEARCH_H_
+#define NAVIGATOR_SHORTEST_PATH_DIJKSTRA_SEARCH_H_
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace s21 {
+
+/** DijkstraSearch
+ *! @brief Labels and binary heap of one Dijkstra search direction. Only
+ *! labelled vertices are reset, so a reused search costs O(settled) per
+ *! query instead of O(V).
+ */
+class DijkstraSearch {
+ public:
+  using Entry = std::pair<size_t, size_t>;  // distance, vertex
+
+  static constexpr size_t kInfinity = std::numeric_limits<size_t>::max();
+  static constexpr size_t kNoVertex = std::numeric_limits<size_t>::max();
+
+  void Reset(size_t size) {
+    if (distance.size() != size) {
+      distance.assign(size, kInfinity);
+      predecessor.assign(size, kNoVertex);
+    } else {
+      for (size_t v : labelled) {
+        distance[v] = kInfinity;
+        predecessor[v] = kNoVertex;
+      }
+    }
+    labelled.clear();
+    heap.clear();
+  }
+  void Label(size_t vertex, size_t new_distance, size_t from) {
+    Label(vertex, new_distance, from, new_distance);
+  }
+  // goal-directed searches order the heap by key instead of distance
+  void Label(size_t vertex, size_t new_distance, size_t from, size_t key) {
+    if (distance[vertex] == kInfinity) labelled.push_back(vertex);
+    distance[vertex] = new_distance;
+    predecessor[vertex] = from;
+    heap.push_back({key, vertex});
+    std::push_heap(heap.begin(), heap.end(), std::greater<Entry>());
+  }
+  Entry Pop() {
+    std::pop_heap(heap.begin(), heap.end(), std::greater<Entry>());
+    Entry entry = heap.back();
+    heap.pop_back();
+    return entry;
+  }
+  // lazy deletion: stale entries are skipped, false when the heap is empty
+  bool PopSettled(size_t &vertex) {
+    while (!heap.empty()) {
+      Entry entry = Pop();
+      if (entry.first == distance[entry.second]) {
+        vertex = entry.second;
+        return true;
+      }
+    }
+    return false;
+  }
+  // Plain Dijkstra from source until target is settled (kNoVertex runs to
+  // completion); for_each_neighbour(vertex, function) calls
+  // function(Neighbour) for every arc leaving vertex.
+  template <typename ForEachNeighbourFunction>
+  void Run(size_t size, size_t source, size_t target,
+           ForEachNeighbourFunction for_each_neighbour) {
+    Reset(size);
+    Label(source, 0, kNoVertex);
+    size_t current = 0;
+    while (PopSettled(current) && current != target) {
+      size_t current_distance = distance[current];
+      for_each_neighbour(current, [&](const auto &neighbour) {
+        size_t temp = current_distance + neighbour.weight;
+        if (temp < distance[neighbour.vertex]) {
+          Label(neighbour.vertex, temp, current);
+        }
+      });
+    }
+  }
+  // lower bound of the next settled distance
+  size_t GetMinDistance() const {
+    return heap.empty() ? kInfinity : heap.front().first;
+  }
+
+  std::vector<size_t> distance;
+  std::vector<size_t> predecessor;
+  std::vector<size_t> labelled;
+  std::vector<Entry> heap;
+};
+
+}  // namespace s21
+
+#endif  // NAVIGATOR_SHORTEST_PATH_DIJKSTRA_SEARCH_H_
@@ -0,0 +1,109 @@
+#include "floyd_warshall.h"
+
+#include <algorithm>
+
+#include "parallel_for.h"
+
+#if defined(__GNUC__) && defined(__x86_64__)
+#define NAVIGATOR_MIN_PLUS_KERNEL \
+  __attribute__((target_clones("avx512f", "avx2", "default")))
+#else
+#define NAVIGATOR_MIN_PLUS_KERNEL
+#endif
+
+namespace s21 {
+
+namespace {
+
+struct Tile {
+  size_t *data;
+  size_t rows;
+  size_t cols;
+};
+
+// c = min(c, a * b) over the (min, +) semiring. Any loop order is exact as
+// long as a or b is already closed, so rows of c stream through cache.
+NAVIGATOR_MIN_PLUS_KERNEL
+void MultiplyTile(Tile c, Tile a, Tile b, size_t stride) {
+  for (size_t i = 0; i < c.rows; ++i) {
+    size_t *row_c = c.data + i * stride;
+    const size_t *row_a = a.data + i * stride;
+    size_t k = 0;
+    // four rows of b per pass, so each element of c is loaded once
+    for (; k + 4 <= a.cols; k += 4) {
+      const size_t distance_0 = row_a[k];
+      const size_t distance_1 = row_a[k + 1];
+      const size_t distance_2 = row_a[k + 2];
+      const size_t distance_3 = row_a[k + 3];
+      const size_t *row_0 = b.data + k * stride;
+      const size_t *row_1 = row_0 + stride;
+      const size_t *row_2 = row_1 + stride;
+      const size_t *row_3 = row_2 + stride;
+      for (size_t j = 0; j < c.cols; ++j) {
+        size_t best = std::min(row_c[j], distance_0 + row_0[j]);
+        best = std::min(best, distance_1 + row_1[j]);
+        best = std::min(best, distance_2 + row_2[j]);
+        row_c[j] = std::min(best, distance_3 + row_3[j]);
+      }
+    }
+    for (; k < a.cols; ++k) {
+      const size_t distance_ik = row_a[k];
+      const size_t *row_b = b.data + k * stride;
+      for (size_t j = 0; j < c.cols; ++j) {
+        row_c[j] = std::min(row_c[j], distance_ik + row_b[j]);
+      }
+    }
+  }
+}
+
+// classic Floyd-Warshall inside one diagonal tile
+NAVIGATOR_MIN_PLUS_KERNEL
+void CloseTile(Tile c, size_t stride) {
+  for (size_t k = 0; k < c.rows; ++k) {
+    const size_t *row_k = c.data + k * stride;
+    for (size_t i = 0; i < c.rows; ++i) {
+      size_t *row_i = c.data + i * stride;
+      const size_t distance_ik = row_i[k];
+      for (size_t j = 0; j < c.cols; ++j) {
+        row_i[j] = std::min(row_i[j], distance_ik + row_k[j]);
+      }
+    }
+  }
+}
+
+}  // namespace
+
+void FloydWarshall::Run(BasicMatrix<size_t> &distances, size_t num_threads) {
+  const size_t size = distances.GetRows();
+  const size_t stride = distances.GetStride();
+  const size_t num_tiles = (size + kBlockSize - 1) / kBlockSize;
+  auto get_tile = [&distances, size](size_t row, size_t col) {
+    row *= kBlockSize;
+    col *= kBlockSize;
+    return Tile{distances[row].data() + col,
+                std::min(kBlockSize, size - row),
+                std::min(kBlockSize, size - col)};
+  };
+  for (size_t k = 0; k < num_tiles; ++k) {
+    Tile diagonal = get_tile(k, k);
+    CloseTile(diagonal, stride);
+    // even indices update row k, odd ones column k
+    ParallelFor(0, 2 * num_tiles, num_threads, [&](size_t index) {
+      size_t j = index / 2;
+      if (j == k) return;
+      if (index % 2 == 0) {
+        MultiplyTile(get_tile(k, j), diagonal, get_tile(k, j), stride);
+      } else {
+        MultiplyTile(get_tile(j, k), get_tile(j, k), diagonal, stride);
+      }
+    });
+    ParallelFor(0, num_tiles * num_tiles, num_threads, [&](size_t index) {
+      size_t i = index / num_tiles;
+      size_t j = index % num_tiles;
+      if (i == k || j == k) return;
+      MultiplyTile(get_tile(i, j), get_tile(i, k), get_tile(k, j), stride);
+    });
+  }
+}
+
+}  // namespace s21
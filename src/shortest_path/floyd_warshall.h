@@ -0,0 +1,33 @@
+#ifndef NAVIGATOR_SHORTEST_PATH_FLOYD_WARSHALL_H_
+#define NAVIGATOR_SHORTEST_PATH_FLOYD_WARSHALL_H_
+
+#include <limits>
+
+#include "matrix.h"
+
+namespace s21 {
+
+/** FloydWarshall
+ *! @brief Blocked all-pairs shortest paths. The matrix is processed in
+ *! square tiles: the diagonal tile of each round is closed first, then its
+ *! row and column, then every other tile with one min-plus product. Tiles
+ *! stay in cache and the inner loop is a branch-free min(c, a + b), which
+ *! is compiled for AVX-512, AVX2 and the baseline and picked at run time.
+ *! Tiles of one phase are independent and are shared between threads.
+ */
+class FloydWarshall {
+ public:
+  // missing edges; half the range, so the sum of two never wraps around
+  static constexpr size_t kInfinity = std::numeric_limits<size_t>::max() / 2;
+  // three 256 x 256 tiles take 1.5 MiB and stay in a 2 MiB L2
+  static const size_t kBlockSize = 256;
+
+  // distances holds edge weights, kInfinity for missing edges and 0 on the
+  // diagonal; on return it holds the path lengths. Path lengths must stay
+  // below kInfinity. num_threads 0 uses every hardware thread.
+  static void Run(BasicMatrix<size_t> &distances, size_t num_threads = 1);
+};
+
+}  // namespace s21
+
+#endif  // NAVIGATOR_SHORTEST_PATH_FLOYD_WARSHALL_H_
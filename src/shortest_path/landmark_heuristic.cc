@@ -0,0 +1,58 @@
+#include "landmark_heuristic.h"
+
+#include <algorithm>
+
+#include "dijkstra_search.h"
+
+namespace s21 {
+
+LandmarkHeuristic::LandmarkHeuristic(const Graph &graph, size_t num_landmarks)
+    : num_vertices_(graph.size()) {
+  num_landmarks = std::min(num_landmarks, num_vertices_);
+  table_.assign(num_vertices_ * 2 * num_landmarks, kUnknown);
+  // distance from the nearest chosen landmark, unreached vertices first
+  std::vector<size_t> nearest(num_vertices_, DijkstraSearch::kInfinity);
+  DijkstraSearch search;
+  size_t landmark = 0;
+  for (size_t i = 0; i < num_landmarks; ++i) {
+    landmarks_.push_back(landmark);
+    const size_t columns = 2 * num_landmarks;
+    search.Run(num_vertices_, landmark, DijkstraSearch::kNoVertex,
+               [&graph](size_t v, auto function) {
+                 graph.ForEachNeighbour(v, function);
+               });
+    for (size_t v = 0; v < num_vertices_; ++v) {
+      size_t distance = search.distance[v];
+      if (distance < kUnknown) table_[v * columns + 2 * i] = distance;
+      nearest[v] = std::min(nearest[v], distance);
+    }
+    search.Run(num_vertices_, landmark, DijkstraSearch::kNoVertex,
+               [&graph](size_t v, auto function) {
+                 graph.ForEachReverseNeighbour(v, function);
+               });
+    for (size_t v = 0; v < num_vertices_; ++v) {
+      size_t distance = search.distance[v];
+      if (distance < kUnknown) table_[v * columns + 2 * i + 1] = distance;
+    }
+    landmark = std::max_element(nearest.begin(), nearest.end()) -
+               nearest.begin();
+  }
+}
+
+size_t LandmarkHeuristic::Estimate(size_t vertex, size_t target) const {
+  const uint32_t *from = GetRow(vertex);
+  const uint32_t *to = GetRow(target);
+  size_t bound = 0;
+  for (size_t i = 0; i < 2 * landmarks_.size(); i += 2) {
+    if (from[i] != kUnknown && to[i] != kUnknown && to[i] > from[i]) {
+      bound = std::max<size_t>(bound, to[i] - from[i]);
+    }
+    if (from[i + 1] != kUnknown && to[i + 1] != kUnknown &&
+        from[i + 1] > to[i + 1]) {
+      bound = std::max<size_t>(bound, from[i + 1] - to[i + 1]);
+    }
+  }
+  return bound;
+}
+
+}  // namespace s21
@@ -0,0 +1,46 @@
+#ifndef NAVIGATOR_SHORTEST_PATH_LANDMARK_HEURISTIC_H_
+#define NAVIGATOR_SHORTEST_PATH_LANDMARK_HEURISTIC_H_
+
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "path_heuristic.h"
+#include "s21_graph.h"
+
+namespace s21 {
+
+/** LandmarkHeuristic
+ *! @brief ALT bounds: distances to and from a few landmarks bound the
+ *! remaining distance by the triangle inequality,
+ *! d(v, t) >= d(L, t) - d(L, v) and d(v, t) >= d(v, L) - d(t, L).
+ *! Landmarks are chosen farthest-first. Both tables are kept per vertex
+ *! as 32-bit values so one query touches a single cache line.
+ */
+class LandmarkHeuristic : public PathHeuristic {
+ public:
+  // distances that do not fit, and unreachable vertices, give no bound
+  static constexpr uint32_t kUnknown = std::numeric_limits<uint32_t>::max();
+  static const size_t kDefaultNumLandmarks = 16;
+
+  explicit LandmarkHeuristic(const Graph &graph,
+                             size_t num_landmarks = kDefaultNumLandmarks);
+
+  size_t GetNumVertices() const override { return num_vertices_; }
+  const std::vector<size_t> &GetLandmarks() const { return landmarks_; }
+  size_t Estimate(size_t vertex, size_t target) const override;
+
+ private:
+  // from landmark i is at 2 * i, to landmark i at 2 * i + 1
+  const uint32_t *GetRow(size_t vertex) const {
+    return &table_[vertex * 2 * landmarks_.size()];
+  }
+
+  size_t num_vertices_;
+  std::vector<size_t> landmarks_;
+  std::vector<uint32_t> table_;
+};
+
+}  // namespace s21
+
+#endif  // NAVIGATOR_SHORTEST_PATH_LANDMARK_HEURISTIC_H_
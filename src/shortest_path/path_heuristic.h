@@ -0,0 +1,76 @@
+#ifndef NAVIGATOR_SHORTEST_PATH_PATH_HEURISTIC_H_
+#define NAVIGATOR_SHORTEST_PATH_PATH_HEURISTIC_H_
+
+#include <cmath>
+#include <stdexcept>
+
+#include "point_set.h"
+
+namespace s21 {
+
+/** PathHeuristic
+ *! @brief Lower bound of the remaining distance for A*. Implementations
+ *! must be consistent: Estimate(u, t) <= w(u, v) + Estimate(v, t) for every
+ *! edge, so each vertex is settled at most once. Internal vertex numbering.
+ */
+class PathHeuristic {
+ public:
+  virtual ~PathHeuristic() = default;
+  virtual size_t GetNumVertices() const = 0;
+  virtual size_t Estimate(size_t vertex, size_t target) const = 0;
+};
+
+/** CoordinateHeuristic
+ *! @brief Straight-line distance between city coordinates, scaled down to
+ *! a lower bound of the TSPLIB weights of the point metric, so it is
+ *! admissible on any graph whose edges carry those weights, complete or
+ *! not. GEO weights are not a function of planar distance and are
+ *! rejected. The points are borrowed from the graph and must outlive the
+ *! heuristic.
+ */
+class CoordinateHeuristic : public PathHeuristic {
+ public:
+  explicit CoordinateHeuristic(const PointSet *points) : points_(points) {
+    if (points_ == nullptr) {
+      throw std::invalid_argument("The graph has no node coordinates");
+    }
+    factor_ = GetFactor(points_->GetMetric());
+  }
+
+  size_t GetNumVertices() const override { return points_->size(); }
+  size_t Estimate(size_t vertex, size_t target) const override {
+    const PointSet::Point &a = (*points_)[vertex];
+    const PointSet::Point &b = (*points_)[target];
+    double dx = a.x - b.x;
+    double dy = a.y - b.y;
+    // floor keeps the bound consistent for integer weights
+    return static_cast<size_t>(factor_ * std::sqrt(dx * dx + dy * dy));
+  }
+
+ private:
+  // largest f with weight >= f * distance for every edge
+  static double GetFactor(PointSet::Metric metric) {
+    switch (metric) {
+      case PointSet::Metric::kEuclidean:
+        // rounding to nearest leaves weight 1 for distances just under 1.5
+        // and never less than that ratio for longer edges
+        return 2.0 / 3.0;
+      case PointSet::Metric::kCeilEuclidean:
+        return 1.0;
+      case PointSet::Metric::kPseudoEuclidean:
+        // ATT rounds sqrt(d^2 / 10) up
+        return 1.0 / std::sqrt(10.0);
+      case PointSet::Metric::kGeo:
+        break;
+    }
+    throw std::invalid_argument(
+        "No coordinate lower bound for GEO edge weights");
+  }
+
+  const PointSet *points_;
+  double factor_;
+};
+
+}  // namespace s21
+
+#endif  // NAVIGATOR_SHORTEST_PATH_PATH_HEURISTIC_H_
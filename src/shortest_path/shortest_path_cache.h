@@ -0,0 +1,98 @@
+#ifndef NAVIGATOR_SHORTEST_PATH_SHORTEST_PATH_CACHE_H_
+#define NAVIGATOR_SHORTEST_PATH_SHORTEST_PATH_CACHE_H_
+
+#include <atomic>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace s21 {
+
+/** ShortestPathCache
+ *! @brief Shortest-path trees of recently queried sources. The least
+ *! recently used trees are dropped once the cached trees exceed the byte
+ *! budget. Safe for concurrent use; trees are shared, so dropping one
+ *! never invalidates a reader.
+ */
+class ShortestPathCache {
+ public:
+  // distances and predecessors of every vertex, as DijkstraSearch leaves
+  // them after a complete search
+  struct Tree {
+    std::vector<size_t> distance;
+    std::vector<size_t> predecessor;
+  };
+
+  explicit ShortestPathCache(size_t bytes) : capacity_(bytes) {}
+
+  size_t GetCapacity() const { return capacity_; }
+  size_t GetBytes() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return bytes_;
+  }
+  size_t GetNumTrees() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return trees_.size();
+  }
+  size_t GetHits() const { return hits_; }
+  // false when one tree of a graph this large exceeds the whole budget
+  bool CanHold(size_t num_vertices) const {
+    return 2 * num_vertices <= capacity_ / sizeof(size_t);
+  }
+  size_t GetMisses() const { return misses_; }
+
+  // nullptr if the tree of source is not cached
+  std::shared_ptr<const Tree> Find(size_t source) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = index_.find(source);
+    if (it == index_.end()) {
+      ++misses_;
+      return nullptr;
+    }
+    ++hits_;
+    trees_.splice(trees_.begin(), trees_, it->second);
+    return it->second->second;
+  }
+  // A tree larger than the whole budget is not kept.
+  void Insert(size_t source, std::shared_ptr<const Tree> tree) {
+    size_t bytes = GetTreeBytes(*tree);
+    if (bytes > capacity_) return;
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = index_.find(source);
+    if (it != index_.end()) {
+      bytes_ -= GetTreeBytes(*it->second->second);
+      trees_.erase(it->second);
+    }
+    trees_.emplace_front(source, std::move(tree));
+    index_[source] = trees_.begin();
+    bytes_ += bytes;
+    while (bytes_ > capacity_) {
+      bytes_ -= GetTreeBytes(*trees_.back().second);
+      index_.erase(trees_.back().first);
+      trees_.pop_back();
+    }
+  }
+
+ private:
+  using Entry = std::pair<size_t, std::shared_ptr<const Tree>>;
+
+  static size_t GetTreeBytes(const Tree &tree) {
+    return (tree.distance.size() + tree.predecessor.size()) * sizeof(size_t);
+  }
+
+  const size_t capacity_;
+  mutable std::mutex mutex_;
+  // most recently used first
+  std::list<Entry> trees_;
+  std::unordered_map<size_t, std::list<Entry>::iterator> index_;
+  size_t bytes_ = 0;
+  std::atomic<size_t> hits_{0};
+  std::atomic<size_t> misses_{0};
+};
+
+}  // namespace s21
+
+#endif  // NAVIGATOR_SHORTEST_PATH_SHORTEST_PATH_CACHE_H_
@@ -0,0 +1,203 @@
+#include "boruvka.h"
+
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <numeric>
+
+#include "edge_sort.h"
+#include "parallel_for.h"
+
+namespace s21 {
+
+namespace {
+
+struct LiveEdge {
+  size_t from;
+  size_t to;
+  size_t weight;
+  size_t index;
+};
+
+constexpr size_t kNone = std::numeric_limits<size_t>::max();
+// edges or vertices handed to a thread at a time
+const size_t kChunkSize = size_t{1} << 14;
+
+// function(begin, end) over chunks of [0, size)
+template <typename Function>
+void ForEachChunk(size_t size, size_t num_threads, Function function) {
+  ParallelFor(0, (size + kChunkSize - 1) / kChunkSize, num_threads,
+              [&](size_t chunk) {
+                function(chunk * kChunkSize,
+                         std::min(size, (chunk + 1) * kChunkSize));
+              });
+}
+
+size_t GetBitWidth(size_t value) {
+  size_t width = 0;
+  for (; value != 0; value >>= 1) ++width;
+  return width;
+}
+
+// Weights themselves when they leave room for an edge position in a key
+// below kNone,
+// otherwise their ranks, which keep the order and always fit.
+std::vector<size_t> GetWeightKeys(const std::vector<CsrStorage::Edge> &edges,
+                                  size_t num_threads) {
+  size_t max_weight = 0;
+  for (const auto &edge : edges) max_weight = std::max(max_weight, edge.weight);
+  std::vector<size_t> keys(edges.size());
+  if (GetBitWidth(max_weight) + GetBitWidth(edges.size()) < 64) {
+    for (size_t e = 0; e < edges.size(); ++e) keys[e] = edges[e].weight;
+    return keys;
+  }
+  std::vector<CsrStorage::Edge> order(edges.size());
+  for (size_t e = 0; e < edges.size(); ++e) {
+    order[e] = {e, 0, edges[e].weight};
+  }
+  SortEdgesByWeight(order, num_threads);
+  size_t rank = 0;
+  for (size_t i = 0; i < order.size(); ++i) {
+    if (i > 0 && order[i].weight != order[i - 1].weight) ++rank;
+    keys[order[i].from] = rank;
+  }
+  return keys;
+}
+
+// keeps the items for which keep(item) holds, in their order
+template <typename T, typename Predicate>
+void Filter(std::vector<T> &items, size_t num_threads, Predicate keep) {
+  size_t num_chunks = (items.size() + kChunkSize - 1) / kChunkSize;
+  std::vector<size_t> offsets(num_chunks + 1, 0);
+  ForEachChunk(items.size(), num_threads, [&](size_t begin, size_t end) {
+    offsets[begin / kChunkSize + 1] =
+        std::count_if(items.begin() + begin, items.begin() + end, keep);
+  });
+  std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+  std::vector<T> kept(offsets.back());
+  ForEachChunk(items.size(), num_threads, [&](size_t begin, size_t end) {
+    std::copy_if(items.begin() + begin, items.begin() + end,
+                 kept.begin() + offsets[begin / kChunkSize], keep);
+  });
+  items.swap(kept);
+}
+
+// moves the ends of the live edges to their new roots in the same pass that
+// counts the edges left between components, then drops the others
+void Contract(std::vector<LiveEdge> &live, const std::vector<size_t> &parent,
+              size_t num_threads) {
+  size_t num_chunks = (live.size() + kChunkSize - 1) / kChunkSize;
+  std::vector<size_t> offsets(num_chunks + 1, 0);
+  ForEachChunk(live.size(), num_threads, [&](size_t begin, size_t end) {
+    size_t count = 0;
+    for (size_t e = begin; e < end; ++e) {
+      live[e].from = parent[live[e].from];
+      live[e].to = parent[live[e].to];
+      count += live[e].from != live[e].to;
+    }
+    offsets[begin / kChunkSize + 1] = count;
+  });
+  std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+  std::vector<LiveEdge> kept(offsets.back());
+  ForEachChunk(live.size(), num_threads, [&](size_t begin, size_t end) {
+    std::copy_if(live.begin() + begin, live.begin() + end,
+                 kept.begin() + offsets[begin / kChunkSize],
+                 [](const LiveEdge &edge) { return edge.from != edge.to; });
+  });
+  live.swap(kept);
+}
+
+}  // namespace
+
+std::vector<size_t> Boruvka::Run(size_t num_vertices,
+                                 const std::vector<CsrStorage::Edge> &edges,
+                                 size_t num_threads) {
+  // Edges between different components, with the component roots as ends.
+  // The stable filters keep them in index order, so the position breaks
+  // ties and key = weight << position_bits | position orders them in one
+  // word for the atomic minimum.
+  std::vector<LiveEdge> live(edges.size());
+  std::vector<size_t> weights = GetWeightKeys(edges, num_threads);
+  ForEachChunk(edges.size(), num_threads, [&](size_t begin, size_t end) {
+    for (size_t e = begin; e < end; ++e) {
+      live[e] = {edges[e].from, edges[e].to, weights[e], e};
+    }
+  });
+  weights = std::vector<size_t>();
+  Filter(live, num_threads,
+         [](const LiveEdge &edge) { return edge.from != edge.to; });
+  const size_t position_bits = GetBitWidth(live.size());
+  const size_t position_mask = (size_t{1} << position_bits) - 1;
+  std::vector<size_t> parent(num_vertices);
+  std::iota(parent.begin(), parent.end(), 0);
+  std::vector<size_t> jump(num_vertices);
+  // key of the lightest edge leaving each root
+  std::vector<std::atomic<size_t>> lightest(num_vertices);
+  std::vector<size_t> roots = parent;
+  std::vector<size_t> forest;
+  while (!live.empty()) {
+    ForEachChunk(roots.size(), num_threads, [&](size_t begin, size_t end) {
+      for (size_t i = begin; i < end; ++i) {
+        lightest[roots[i]].store(kNone, std::memory_order_relaxed);
+      }
+    });
+    ForEachChunk(live.size(), num_threads, [&](size_t begin, size_t end) {
+      for (size_t e = begin; e < end; ++e) {
+        size_t key = live[e].weight << position_bits | e;
+        for (size_t root : {live[e].from, live[e].to}) {
+          size_t current = lightest[root].load(std::memory_order_relaxed);
+          while (key < current &&
+                 !lightest[root].compare_exchange_weak(
+                     current, key, std::memory_order_relaxed)) {
+          }
+        }
+      }
+    });
+    // Every root hooks onto the other end of its lightest edge. With a
+    // strict order the only cycles are pairs sharing that edge, where the
+    // smaller root stays a root.
+    ForEachChunk(roots.size(), num_threads, [&](size_t begin, size_t end) {
+      for (size_t i = begin; i < end; ++i) {
+        size_t root = roots[i];
+        size_t key = lightest[root].load(std::memory_order_relaxed);
+        if (key == kNone) continue;
+        const LiveEdge &edge = live[key & position_mask];
+        size_t other = edge.from == root ? edge.to : edge.from;
+        if (root < other &&
+            lightest[other].load(std::memory_order_relaxed) == key) {
+          continue;
+        }
+        parent[root] = other;
+      }
+    });
+    for (size_t root : roots) {
+      if (parent[root] != root) {
+        size_t key = lightest[root].load(std::memory_order_relaxed);
+        forest.push_back(live[key & position_mask].index);
+      }
+    }
+    std::atomic<bool> changed(true);
+    while (changed) {
+      changed = false;
+      ForEachChunk(roots.size(), num_threads, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+          size_t root = roots[i];
+          jump[root] = parent[parent[root]];
+          if (jump[root] != parent[root]) {
+            changed.store(true, std::memory_order_relaxed);
+          }
+        }
+      });
+      ForEachChunk(roots.size(), num_threads, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) parent[roots[i]] = jump[roots[i]];
+      });
+    }
+    Filter(roots, num_threads,
+           [&parent](size_t root) { return parent[root] == root; });
+    if (roots.size() == 1) break;
+    Contract(live, parent, num_threads);
+  }
+  return forest;
+}
+
+}  // namespace s21
@@ -0,0 +1,30 @@
+#ifndef NAVIGATOR_SPANNING_TREE_BORUVKA_H_
+#define NAVIGATOR_SPANNING_TREE_BORUVKA_H_
+
+#include <vector>
+
+#include "csr_storage.h"
+
+namespace s21 {
+
+/** Boruvka
+ *! @brief Parallel Boruvka minimum spanning forest. Each round every
+ *! component picks its lightest outgoing edge with an atomic compare-and-
+ *! swap minimum, hooks itself onto the other end, and pointer jumping
+ *! relabels the merged components; edges inside a component are then
+ *! filtered out. At least half the components disappear per round, so
+ *! there are at most log2(V) rounds of O(E / threads) work each.
+ */
+class Boruvka {
+ public:
+  // Indices in edges of the forest of the undirected graph on vertices
+  // 0..num_vertices-1. Equal weights are ordered by index, so the forest is
+  // the one Kruskal finds after a stable sort of the same edges.
+  static std::vector<size_t> Run(size_t num_vertices,
+                                 const std::vector<CsrStorage::Edge> &edges,
+                                 size_t num_threads = 1);
+};
+
+}  // namespace s21
+
+#endif  // NAVIGATOR_SPANNING_TREE_BORUVKA_H_
@@ -0,0 +1,55 @@
+#ifndef NAVIGATOR_SPANNING_TREE_DISJOINT_SET_H_
+#define NAVIGATOR_SPANNING_TREE_DISJOINT_SET_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+namespace s21 {
+
+/** DisjointSet
+ *! @brief Union-find over elements 0..size-1 with union by rank and path
+ *! halving, so a sequence of operations runs in near-constant amortised
+ *! time per operation.
+ */
+class DisjointSet {
+ public:
+  explicit DisjointSet(size_t size)
+      : parent_(size), rank_(size, 0), num_sets_(size) {
+    std::iota(parent_.begin(), parent_.end(), 0);
+  }
+
+  size_t size() const { return parent_.size(); }
+  size_t GetNumSets() const { return num_sets_; }
+
+  size_t Find(size_t element) {
+    while (parent_[element] != element) {
+      parent_[element] = parent_[parent_[element]];
+      element = parent_[element];
+    }
+    return element;
+  }
+  // false if both elements already were in one set
+  bool Unite(size_t a, size_t b) {
+    a = Find(a);
+    b = Find(b);
+    if (a == b) return false;
+    if (rank_[a] < rank_[b]) std::swap(a, b);
+    parent_[b] = a;
+    if (rank_[a] == rank_[b]) ++rank_[a];
+    --num_sets_;
+    return true;
+  }
+
+ private:
+  std::vector<size_t> parent_;
+  // bounded by log2(size)
+  std::vector<uint8_t> rank_;
+  size_t num_sets_;
+};
+
+}  // namespace s21
+
+#endif  // NAVIGATOR_SPANNING_TREE_DISJOINT_SET_H_
@@ -0,0 +1,350 @@
+#include "dynamic_spanning_forest.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <tuple>
+
+#include "disjoint_set.h"
+#include "edge_sort.h"
+
+namespace s21 {
+
+DynamicSpanningForest::DynamicSpanningForest(const Graph &graph,
+                                             size_t first_vertex)
+    : size_(graph.size()), first_vertex_(first_vertex) {
+  if (!graph.GraphOrientationCheck()) {
+    throw std::invalid_argument("Graph is not oriented");
+  }
+  edges_.reserve(graph.GetNumEdges() / 2);
+  edge_index_.reserve(graph.GetNumEdges() / 2);
+  for (size_t i = 0; i < size_; ++i) {
+    graph.ForEachNeighbour(i, [&](const Graph::Neighbour &neighbour) {
+      if (neighbour.vertex > i) {
+        edge_index_[GetKey(i, neighbour.vertex)] = edges_.size();
+        edges_.push_back({i, neighbour.vertex, neighbour.weight, kNil});
+      }
+    });
+  }
+  Rebuild();
+}
+
+size_t DynamicSpanningForest::GetEdge(size_t from, size_t to) const {
+  from = ToInternal(from);
+  to = ToInternal(to);
+  if (from > to) std::swap(from, to);
+  auto it = edge_index_.find(GetKey(from, to));
+  return it == edge_index_.end() ? 0 : edges_[it->second].weight;
+}
+
+void DynamicSpanningForest::SetEdge(size_t from, size_t to, size_t weight) {
+  from = ToInternal(from);
+  to = ToInternal(to);
+  if (from == to) {
+    throw std::invalid_argument("A loop cannot be a spanning tree edge");
+  }
+  if (from > to) std::swap(from, to);
+  auto it = edge_index_.find(GetKey(from, to));
+  if (it == edge_index_.end()) {
+    if (weight == 0) return;
+    edge_index_.emplace(GetKey(from, to), edges_.size());
+    edges_.push_back({from, to, weight, kNil});
+    if (!stale_) Insert(edges_.size() - 1);
+    return;
+  }
+  size_t index = it->second;
+  EdgeInfo &edge = edges_[index];
+  if (weight == 0 || weight > edge.weight) {
+    // a forest edge may now have a lighter replacement anywhere
+    if (edge.node != kNil) stale_ = true;
+    if (weight == 0) {
+      RemoveAt(index);
+    } else {
+      edge.weight = weight;
+    }
+  } else if (weight < edge.weight && !stale_) {
+    if (edge.node != kNil) {
+      // still the lightest edge across its cut
+      Access(edge.node);
+      weight_ -= edge.weight - weight;
+      nodes_[edge.node].weight = weight;
+      Update(edge.node);
+      edge.weight = weight;
+    } else {
+      edge.weight = weight;
+      Insert(index);
+    }
+  } else {
+    edge.weight = weight;
+  }
+}
+
+size_t DynamicSpanningForest::GetWeight() {
+  if (stale_) Rebuild();
+  return weight_;
+}
+
+size_t DynamicSpanningForest::GetNumComponents() {
+  if (stale_) Rebuild();
+  return num_components_;
+}
+
+std::vector<CsrStorage::Edge> DynamicSpanningForest::GetEdges() {
+  if (stale_) Rebuild();
+  std::vector<CsrStorage::Edge> forest;
+  forest.reserve(size_ - num_components_);
+  for (size_t index : node_edges_) {
+    if (index != kNil) {
+      const EdgeInfo &edge = edges_[index];
+      forest.push_back(
+          {edge.from + first_vertex_, edge.to + first_vertex_, edge.weight});
+    }
+  }
+  std::sort(forest.begin(), forest.end(),
+            [](const CsrStorage::Edge &a, const CsrStorage::Edge &b) {
+              return std::tie(a.weight, a.from, a.to) <
+                     std::tie(b.weight, b.from, b.to);
+            });
+  return forest;
+}
+
+size_t DynamicSpanningForest::ToInternal(size_t vertex) const {
+  if (vertex < first_vertex_ || vertex - first_vertex_ >= size_) {
+    throw std::out_of_range("The vertex is not in the graph");
+  }
+  return vertex - first_vertex_;
+}
+
+void DynamicSpanningForest::RemoveAt(size_t index) {
+  edge_index_.erase(GetKey(edges_[index].from, edges_[index].to));
+  if (index + 1 != edges_.size()) {
+    const EdgeInfo &last = edges_.back();
+    edge_index_[GetKey(last.from, last.to)] = index;
+    if (last.node != kNil) node_edges_[last.node - size_] = index;
+    edges_[index] = last;
+  }
+  edges_.pop_back();
+}
+
+void DynamicSpanningForest::Rebuild() {
+  // a forest has at most size_ - 1 edges
+  size_t num_edge_nodes = size_ == 0 ? 0 : size_ - 1;
+  nodes_.assign(size_ + num_edge_nodes, Node());
+  for (size_t x = 0; x < nodes_.size(); ++x) nodes_[x].heaviest = x;
+  node_edges_.assign(num_edge_nodes, kNil);
+  free_nodes_.resize(num_edge_nodes);
+  for (size_t i = 0; i < num_edge_nodes; ++i) {
+    free_nodes_[i] = nodes_.size() - 1 - i;
+  }
+  // Kruskal over the edge positions sorted by weight
+  std::vector<CsrStorage::Edge> order(edges_.size());
+  for (size_t i = 0; i < edges_.size(); ++i) {
+    order[i] = {i, 0, edges_[i].weight};
+    edges_[i].node = kNil;
+  }
+  SortEdgesByWeight(order, 1);
+  weight_ = 0;
+  num_components_ = size_;
+  DisjointSet components(size_);
+  for (const CsrStorage::Edge &entry : order) {
+    EdgeInfo &edge = edges_[entry.from];
+    if (components.Unite(edge.from, edge.to)) {
+      edge.node = free_nodes_.back();
+      free_nodes_.pop_back();
+      nodes_[edge.node].weight = edge.weight;
+      node_edges_[edge.node - size_] = entry.from;
+      weight_ += edge.weight;
+      --num_components_;
+      if (components.GetNumSets() == 1) break;
+    }
+  }
+  LinkForest();
+  stale_ = false;
+  ++num_rebuilds_;
+}
+
+void DynamicSpanningForest::LinkForest() {
+  // forest adjacency of the vertices, each edge through its node
+  std::vector<size_t> offsets(size_ + 1, 0);
+  for (size_t index : node_edges_) {
+    if (index == kNil) continue;
+    ++offsets[edges_[index].from + 1];
+    ++offsets[edges_[index].to + 1];
+  }
+  for (size_t v = 0; v < size_; ++v) offsets[v + 1] += offsets[v];
+  std::vector<size_t> incident(offsets.back());
+  std::vector<size_t> position(offsets.begin(), offsets.end() - 1);
+  for (size_t i = 0; i < node_edges_.size(); ++i) {
+    if (node_edges_[i] == kNil) continue;
+    const EdgeInfo &edge = edges_[node_edges_[i]];
+    incident[position[edge.from]++] = size_ + i;
+    incident[position[edge.to]++] = size_ + i;
+  }
+  // Each tree is rooted at its first vertex and every node keeps only its
+  // path-parent pointer, which is a valid link-cut tree without preferred
+  // paths; linking edge by edge would cost O(V log V).
+  std::vector<bool> visited(size_, false);
+  std::vector<size_t> stack;
+  for (size_t root = 0; root < size_; ++root) {
+    if (visited[root]) continue;
+    visited[root] = true;
+    stack.push_back(root);
+    while (!stack.empty()) {
+      size_t vertex = stack.back();
+      stack.pop_back();
+      for (size_t i = offsets[vertex]; i < offsets[vertex + 1]; ++i) {
+        size_t node = incident[i];
+        const EdgeInfo &edge = edges_[node_edges_[node - size_]];
+        size_t next = edge.from == vertex ? edge.to : edge.from;
+        if (visited[next]) continue;
+        visited[next] = true;
+        nodes_[node].parent = vertex;
+        nodes_[next].parent = node;
+        stack.push_back(next);
+      }
+    }
+  }
+}
+
+void DynamicSpanningForest::Insert(size_t index) {
+  size_t from = edges_[index].from;
+  size_t to = edges_[index].to;
+  if (FindRoot(from) != FindRoot(to)) {
+    LinkEdge(index);
+    return;
+  }
+  MakeRoot(from);
+  Access(to);
+  size_t heaviest = nodes_[to].heaviest;
+  if (nodes_[heaviest].weight <= edges_[index].weight) return;
+  CutEdge(heaviest);
+  LinkEdge(index);
+}
+
+void DynamicSpanningForest::LinkEdge(size_t index) {
+  EdgeInfo &edge = edges_[index];
+  size_t node = free_nodes_.back();
+  free_nodes_.pop_back();
+  nodes_[node] = Node();
+  nodes_[node].heaviest = node;
+  nodes_[node].weight = edge.weight;
+  node_edges_[node - size_] = index;
+  Link(edge.from, node);
+  Link(node, edge.to);
+  edge.node = node;
+  weight_ += edge.weight;
+  --num_components_;
+}
+
+void DynamicSpanningForest::CutEdge(size_t node) {
+  EdgeInfo &edge = edges_[node_edges_[node - size_]];
+  Cut(edge.from, node);
+  Cut(node, edge.to);
+  edge.node = kNil;
+  node_edges_[node - size_] = kNil;
+  free_nodes_.push_back(node);
+  weight_ -= nodes_[node].weight;
+  ++num_components_;
+}
+
+bool DynamicSpanningForest::IsSplayRoot(size_t x) const {
+  size_t parent = nodes_[x].parent;
+  return parent == kNil || (nodes_[parent].child[0] != x &&
+                            nodes_[parent].child[1] != x);
+}
+
+void DynamicSpanningForest::Update(size_t x) {
+  size_t heaviest = x;
+  for (size_t child : nodes_[x].child) {
+    if (child != kNil &&
+        nodes_[nodes_[child].heaviest].weight > nodes_[heaviest].weight) {
+      heaviest = nodes_[child].heaviest;
+    }
+  }
+  nodes_[x].heaviest = heaviest;
+}
+
+void DynamicSpanningForest::Push(size_t x) {
+  if (!nodes_[x].flipped) return;
+  std::swap(nodes_[x].child[0], nodes_[x].child[1]);
+  for (size_t child : nodes_[x].child) {
+    if (child != kNil) nodes_[child].flipped = !nodes_[child].flipped;
+  }
+  nodes_[x].flipped = false;
+}
+
+void DynamicSpanningForest::Rotate(size_t x) {
+  size_t parent = nodes_[x].parent;
+  size_t grandparent = nodes_[parent].parent;
+  int side = nodes_[parent].child[1] == x;
+  if (!IsSplayRoot(parent)) {
+    nodes_[grandparent].child[nodes_[grandparent].child[1] == parent] = x;
+  }
+  nodes_[x].parent = grandparent;
+  size_t inner = nodes_[x].child[1 - side];
+  nodes_[parent].child[side] = inner;
+  if (inner != kNil) nodes_[inner].parent = parent;
+  nodes_[x].child[1 - side] = parent;
+  nodes_[parent].parent = x;
+  Update(parent);
+  Update(x);
+}
+
+void DynamicSpanningForest::Splay(size_t x) {
+  splay_path_.clear();
+  for (size_t y = x;; y = nodes_[y].parent) {
+    splay_path_.push_back(y);
+    if (IsSplayRoot(y)) break;
+  }
+  for (auto it = splay_path_.rbegin(); it != splay_path_.rend(); ++it) {
+    Push(*it);
+  }
+  while (!IsSplayRoot(x)) {
+    size_t parent = nodes_[x].parent;
+    if (!IsSplayRoot(parent)) {
+      size_t grandparent = nodes_[parent].parent;
+      bool zig_zig = (nodes_[parent].child[0] == x) ==
+                     (nodes_[grandparent].child[0] == parent);
+      Rotate(zig_zig ? parent : x);
+    }
+    Rotate(x);
+  }
+}
+
+void DynamicSpanningForest::Access(size_t x) {
+  size_t last = kNil;
+  for (size_t y = x; y != kNil; y = nodes_[y].parent) {
+    Splay(y);
+    nodes_[y].child[1] = last;
+    Update(y);
+    last = y;
+  }
+  Splay(x);
+}
+
+void DynamicSpanningForest::MakeRoot(size_t x) {
+  Access(x);
+  nodes_[x].flipped = !nodes_[x].flipped;
+}
+
+size_t DynamicSpanningForest::FindRoot(size_t x) {
+  Access(x);
+  for (Push(x); nodes_[x].child[0] != kNil; Push(x)) x = nodes_[x].child[0];
+  Splay(x);
+  return x;
+}
+
+void DynamicSpanningForest::Link(size_t x, size_t y) {
+  MakeRoot(x);
+  nodes_[x].parent = y;
+}
+
+void DynamicSpanningForest::Cut(size_t x, size_t y) {
+  MakeRoot(x);
+  Access(y);
+  // x is the only node before y on the path
+  nodes_[y].child[0] = kNil;
+  nodes_[x].parent = kNil;
+  Update(y);
+}
+
+}  // namespace s21
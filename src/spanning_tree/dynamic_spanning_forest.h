@@ -0,0 +1,109 @@
+#ifndef NAVIGATOR_SPANNING_TREE_DYNAMIC_SPANNING_FOREST_H_
+#define NAVIGATOR_SPANNING_TREE_DYNAMIC_SPANNING_FOREST_H_
+
+#include <cstdint>
+#include <limits>
+#include <unordered_map>
+#include <vector>
+
+#include "csr_storage.h"
+#include "s21_graph.h"
+
+namespace s21 {
+
+/** DynamicSpanningForest
+ *! @brief Minimum spanning forest of an undirected graph kept up to date
+ *! while edges change. The forest lives in a link-cut tree with one node
+ *! per vertex and one per forest edge, so the heaviest edge on a forest
+ *! path is found in O(log V) amortised time: an inserted or lighter edge
+ *! replaces it when that is cheaper (cycle property). Removing or raising
+ *! a forest edge may need any other edge as replacement, so it only marks
+ *! the forest stale and the next read rebuilds it with Kruskal; a batch of
+ *! such changes costs one rebuild. Vertices are numbered from
+ *! first_vertex in every argument and result.
+ */
+class DynamicSpanningForest {
+ public:
+  explicit DynamicSpanningForest(const Graph &graph, size_t first_vertex = 0);
+
+  size_t size() const { return size_; }
+  size_t GetNumEdges() const { return edges_.size(); }
+  size_t GetNumRebuilds() const { return num_rebuilds_; }
+  // 0 if there is no edge
+  size_t GetEdge(size_t from, size_t to) const;
+  // Inserts the edge, changes its weight or removes it with weight 0.
+  void SetEdge(size_t from, size_t to, size_t weight);
+  void RemoveEdge(size_t from, size_t to) { SetEdge(from, to, 0); }
+
+  size_t GetWeight();
+  size_t GetNumComponents();
+  // from smaller to larger vertex, by weight and then by vertices
+  std::vector<CsrStorage::Edge> GetEdges();
+
+ private:
+  static constexpr size_t kNil = std::numeric_limits<size_t>::max();
+
+  struct EdgeInfo {
+    size_t from;
+    size_t to;
+    size_t weight;
+    // link-cut tree node while the edge is in the forest, kNil otherwise
+    size_t node;
+  };
+  struct Node {
+    size_t parent = kNil;
+    size_t child[2] = {kNil, kNil};
+    // node of the heaviest edge in the splay subtree
+    size_t heaviest = kNil;
+    size_t weight = 0;
+    bool flipped = false;
+  };
+
+  uint64_t GetKey(size_t from, size_t to) const {
+    return static_cast<uint64_t>(from) * size_ + to;
+  }
+  // internal number of vertex, throws std::out_of_range
+  size_t ToInternal(size_t vertex) const;
+  // swaps the last edge into the place of the removed one
+  void RemoveAt(size_t index);
+  void Rebuild();
+  // link-cut tree of the forest edges
+  void LinkForest();
+  // adds edges_[index] to the forest if it joins two trees or is lighter
+  // than the heaviest edge on the forest path between its ends
+  void Insert(size_t index);
+  void LinkEdge(size_t index);
+  void CutEdge(size_t node);
+
+  // link-cut tree over nodes_
+  bool IsSplayRoot(size_t x) const;
+  void Update(size_t x);
+  void Push(size_t x);
+  void Rotate(size_t x);
+  void Splay(size_t x);
+  void Access(size_t x);
+  void MakeRoot(size_t x);
+  size_t FindRoot(size_t x);
+  void Link(size_t x, size_t y);
+  void Cut(size_t x, size_t y);
+
+  size_t size_;
+  size_t first_vertex_;
+  std::vector<EdgeInfo> edges_;
+  // position in edges_ by key of (smaller, larger) vertex
+  std::unordered_map<uint64_t, size_t> edge_index_;
+  // vertices first, then edge nodes
+  std::vector<Node> nodes_;
+  // position in edges_ of the edge of node size_ + i, kNil if unused
+  std::vector<size_t> node_edges_;
+  std::vector<size_t> free_nodes_;
+  std::vector<size_t> splay_path_;
+  size_t weight_ = 0;
+  size_t num_components_ = 0;
+  bool stale_ = false;
+  size_t num_rebuilds_ = 0;
+};
+
+}  // namespace s21
+
+#endif  // NAVIGATOR_SPANNING_TREE_DYNAMIC_SPANNING_FOREST_H_
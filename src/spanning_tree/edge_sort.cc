@@ -0,0 +1,68 @@
+#include "edge_sort.h"
+
+#include <algorithm>
+
+#include "parallel_for.h"
+
+namespace s21 {
+
+namespace {
+
+const size_t kDigitBits = 11;
+const size_t kNumBuckets = size_t{1} << kDigitBits;
+// below this a chunk is not worth a thread
+const size_t kMinChunkSize = size_t{1} << 14;
+
+}  // namespace
+
+void SortEdgesByWeight(std::vector<CsrStorage::Edge> &edges,
+                       size_t num_threads) {
+  const size_t size = edges.size();
+  if (size < 2) return;
+  size_t max_weight = 0;
+  for (const auto &edge : edges) max_weight = std::max(max_weight, edge.weight);
+  size_t num_chunks = std::min(GetNumThreads(num_threads),
+                               (size + kMinChunkSize - 1) / kMinChunkSize);
+  num_chunks = std::max<size_t>(num_chunks, 1);
+  const size_t chunk_size = (size + num_chunks - 1) / num_chunks;
+  std::vector<CsrStorage::Edge> buffer(size);
+  // counts of chunk c are at c * kNumBuckets, later its scatter positions
+  std::vector<size_t> positions(num_chunks * kNumBuckets);
+  for (size_t shift = 0; shift < 64 && (max_weight >> shift) != 0;
+       shift += kDigitBits) {
+    std::fill(positions.begin(), positions.end(), 0);
+    ParallelFor(0, num_chunks, num_threads, [&](size_t chunk) {
+      size_t *count = &positions[chunk * kNumBuckets];
+      size_t last = std::min(size, (chunk + 1) * chunk_size);
+      for (size_t i = chunk * chunk_size; i < last; ++i) {
+        ++count[(edges[i].weight >> shift) & (kNumBuckets - 1)];
+      }
+    });
+    // bucket-major, chunk-minor prefix sums keep the sort stable
+    size_t total = 0;
+    bool single_bucket = false;
+    for (size_t digit = 0; digit < kNumBuckets; ++digit) {
+      size_t digit_total = 0;
+      for (size_t chunk = 0; chunk < num_chunks; ++chunk) {
+        size_t &position = positions[chunk * kNumBuckets + digit];
+        size_t count = position;
+        position = total;
+        total += count;
+        digit_total += count;
+      }
+      if (digit_total == size) single_bucket = true;
+    }
+    if (single_bucket) continue;
+    ParallelFor(0, num_chunks, num_threads, [&](size_t chunk) {
+      size_t *position = &positions[chunk * kNumBuckets];
+      size_t last = std::min(size, (chunk + 1) * chunk_size);
+      for (size_t i = chunk * chunk_size; i < last; ++i) {
+        buffer[position[(edges[i].weight >> shift) & (kNumBuckets - 1)]++] =
+            edges[i];
+      }
+    });
+    edges.swap(buffer);
+  }
+}
+
+}  // namespace s21
@@ -0,0 +1,21 @@
+#ifndef NAVIGATOR_SPANNING_TREE_EDGE_SORT_H_
+#define NAVIGATOR_SPANNING_TREE_EDGE_SORT_H_
+
+#include <vector>
+
+#include "csr_storage.h"
+
+namespace s21 {
+
+/** SortEdgesByWeight
+ *! @brief Stable LSD radix sort of edges by weight with 11-bit digits; only
+ *! the digits below the largest weight are sorted, and a digit shared by
+ *! every edge is skipped. Each pass counts and scatters contiguous chunks
+ *! of edges on num_threads threads (0 uses every hardware thread).
+ */
+void SortEdgesByWeight(std::vector<CsrStorage::Edge> &edges,
+                       size_t num_threads = 0);
+
+}  // namespace s21
+
+#endif  // NAVIGATOR_SPANNING_TREE_EDGE_SORT_H_
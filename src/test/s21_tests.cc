@@ -1,7 +1,22 @@
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <cmath>
 #include <fstream>
+#include <map>
+#include <numeric>
+#include <random>
 
+#include "ant_colony_algorithm.h"
+#include "binary_graph_file.h"
+#include "boruvka.h"
+#include "branch_and_bound.h"
+#include "disjoint_set.h"
+#include "distance_matrix_file.h"
+#include "edge_sort.h"
+#include "floyd_warshall.h"
+#include "held_karp.h"
+#include "local_search.h"
 #include "s21_graph.h"
 #include "s21_graph_algorithms.h"
 using namespace s21;
@@ -20,6 +35,18 @@ bool CompareFiles(const std::string &file1, const std::string &file2) {
   return !f1.eof() || !f2.eof();
 }
 
+void WriteRingGraph(const std::string &file_name, size_t size) {
+  std::ofstream file(file_name);
+  file << size << std::endl;
+  for (size_t i = 0; i < size; ++i) {
+    for (size_t j = 0; j < size; ++j) {
+      bool ring_edge = (j == (i + 1) % size) || (i == (j + 1) % size);
+      file << (ring_edge ? 1 + std::min(i, j) : 0) << " ";
+    }
+    file << std::endl;
+  }
+}
+
 TEST(Graph, LoadGraphFromFile_File_empty) {
   try {
     Graph graph;
@@ -61,6 +88,47 @@ TEST(Graph, LoadGraphFromFile_to_incorrect_size_1) {
   ASSERT_ANY_THROW(graph.LoadGraphFromFile(file_name));
 }
 
+TEST(Graph, LoadGraphFromFile_error_position) {
+  Graph graph;
+  std::string file_name = "samples/to_incorrect_size_graph_2.adj";
+  try {
+    graph.LoadGraphFromFile(file_name);
+    FAIL();
+  } catch (const std::invalid_argument &e) {
+    ASSERT_STREQ(
+        "File read error. Line 5, column 2: expected 4 numbers, found 1.",
+        e.what());
+  }
+  std::ofstream("temp_bad.adj") << "2\n0 1\n1 x\n";
+  try {
+    graph.LoadGraphFromFile("temp_bad.adj");
+    FAIL();
+  } catch (const std::invalid_argument &e) {
+    ASSERT_STREQ(
+        "File read error. Line 3, column 3: expected a non-negative number.",
+        e.what());
+  }
+}
+
+TEST(Graph, LoadGraphFromFile_att48) {
+  Graph graph;
+  graph.LoadGraphFromFile("samples/att48_33523.txt");
+  EXPECT_EQ(graph.size(), 48);
+  EXPECT_EQ(graph.GetEdge(0, 1), 4727);
+  EXPECT_EQ(graph.GetEdge(1, 0), 4727);
+  EXPECT_TRUE(graph.GraphOrientationCheck());
+}
+
+TEST(Graph, LoadGraphFromFile_large) {
+  std::string file_name = "temp_ring.adj";
+  WriteRingGraph(file_name, 3000);
+  Graph graph;
+  graph.LoadGraphFromFile(file_name, Graph::Representation::kSparse);
+  EXPECT_EQ(graph.size(), 3000);
+  EXPECT_EQ(graph.GetNumEdges(), 6000);
+  EXPECT_EQ(graph.GetEdge(2998, 2999), 2999);
+}
+
 TEST(Graph, LoadGraphFromFile_0) {
   Graph graph;
   std::string file_name = "samples/graph_1.adj";
@@ -108,6 +176,284 @@ TEST(Graph, LoadGraphFromFile_1) {
   }
 }
 
+TEST(Graph, LoadGraphFromFile_sparse) {
+  Graph dense;
+  Graph sparse;
+  std::string file_name = "samples/matrices/matrices/test_1.txt";
+  dense.LoadGraphFromFile(file_name);
+  sparse.LoadGraphFromFile(file_name, Graph::Representation::kSparse);
+  EXPECT_EQ(sparse.GetRepresentation(), Graph::Representation::kSparse);
+  EXPECT_EQ(sparse.size(), 10);
+  EXPECT_EQ(sparse.GetNumEdges(), 21);
+  EXPECT_ANY_THROW(sparse.GetMatrix());
+  for (size_t i = 0; i < dense.size(); ++i) {
+    for (size_t j = 0; j < dense.size(); ++j) {
+      EXPECT_EQ(sparse.GetEdge(i, j), dense.GetEdge(i, j));
+    }
+  }
+}
+
+TEST(Graph, LoadGraphFromFile_above_100) {
+  Graph graph;
+  std::string file_name = "temp_ring.adj";
+  WriteRingGraph(file_name, 250);
+  graph.LoadGraphFromFile(file_name);
+  EXPECT_EQ(graph.size(), 250);
+  EXPECT_EQ(graph.GetRepresentation(), Graph::Representation::kDense);
+  EXPECT_EQ(graph.GetNumEdges(), 500);
+  EXPECT_EQ(graph.GetEdge(10, 11), 11);
+  EXPECT_EQ(graph.GetEdge(0, 249), 1);
+  EXPECT_EQ(GraphAlgorithms::GetShortestPathBetweenVertices(graph, 1, 250), 1);
+}
+
+TEST(Graph, LoadGraphFromFile_memory_limit) {
+  std::string file_name = "temp_ring.adj";
+  WriteRingGraph(file_name, 250);
+  Graph graph;
+  graph.SetMemoryLimit(64 * 1024);
+  graph.LoadGraphFromFile(file_name);
+  EXPECT_EQ(graph.GetRepresentation(), Graph::Representation::kSparse);
+  EXPECT_EQ(graph.GetEdge(10, 11), 11);
+  EXPECT_ANY_THROW(
+      graph.LoadGraphFromFile(file_name, Graph::Representation::kDense));
+  graph.SetMemoryLimit(4 * 1024);
+  EXPECT_ANY_THROW(graph.LoadGraphFromFile(file_name));
+  EXPECT_EQ(graph.size(), 250);
+  EXPECT_LE(Graph::EstimateMemory(Graph::Representation::kSparse, 250, 500),
+            64 * 1024);
+}
+
+TEST(Graph, LoadGraphFromTsplibFile_coordinates) {
+  Graph matrix;
+  matrix.LoadGraphFromFile("samples/att48_33523.txt");
+  Graph graph;
+  graph.LoadGraphFromFile("samples/tsplib/att48.tsp");
+  ASSERT_EQ(graph.size(), 48);
+  ASSERT_NE(graph.GetPointSet(), nullptr);
+  EXPECT_EQ(graph.GetPointSet()->size(), 48);
+  EXPECT_EQ(graph.GetMatrix(), matrix.GetMatrix());
+  graph.LoadGraphFromFile("samples/graph_4.adj");
+  EXPECT_EQ(graph.GetPointSet(), nullptr);
+}
+
+TEST(Graph, LoadGraphFromTsplibFile_explicit) {
+  Graph matrix;
+  matrix.LoadGraphFromFile("samples/dantzig42_699.adj.txt");
+  Graph graph;
+  graph.LoadGraphFromTsplibFile("samples/tsplib/dantzig42.tsp",
+                                Graph::Representation::kSparse);
+  ASSERT_EQ(graph.size(), 42);
+  EXPECT_EQ(graph.GetPointSet(), nullptr);
+  for (size_t i = 0; i < 42; ++i) {
+    for (size_t j = 0; j < 42; ++j) {
+      EXPECT_EQ(graph.GetEdge(i, j), matrix.GetEdge(i, j));
+    }
+  }
+}
+
+TEST(Graph, LoadGraphFromTsplibFile_bad) {
+  std::string file_name = "temp.tsp";
+  std::ofstream(file_name) << "TYPE : TSP\nDIMENSION : 3\n"
+                           << "EDGE_WEIGHT_TYPE : MAN_3D\n"
+                           << "NODE_COORD_SECTION\n1 0 0\n2 1 1\n3 2 2\n";
+  Graph graph;
+  EXPECT_THROW(graph.LoadGraphFromFile(file_name), std::invalid_argument);
+  std::ofstream(file_name) << "TYPE : TSP\nDIMENSION : 3\n"
+                           << "EDGE_WEIGHT_TYPE : EUC_2D\n"
+                           << "NODE_COORD_SECTION\n1 0 0\n2 3 4\n";
+  EXPECT_THROW(graph.LoadGraphFromFile(file_name), std::invalid_argument);
+  std::ofstream(file_name) << "TYPE : TSP\nDIMENSION : 3\n"
+                           << "EDGE_WEIGHT_TYPE : EUC_2D\n"
+                           << "NODE_COORD_SECTION\n1 0 0\n2 3 4\n3 6 8\n";
+  graph.LoadGraphFromFile(file_name);
+  EXPECT_EQ(graph.GetEdge(0, 1), 5);
+  EXPECT_EQ(graph.GetEdge(2, 0), 10);
+  EXPECT_EQ(graph.GetEdge(1, 1), 0);
+}
+
+TEST(Graph, LoadGraphFromTsplibFile_huge_dimension) {
+  std::string file_name = "temp.tsp";
+  Graph graph;
+  graph.LoadGraphFromFile("samples/graph_4.adj");
+  // n * n wraps around to 0 for the first; the others fit in size_t but
+  // not in the memory limit
+  for (const char *dimension : {"4294967296", "3000000", "20000"}) {
+    std::ofstream(file_name) << "TYPE : TSP\nDIMENSION : " << dimension
+                             << "\nEDGE_WEIGHT_TYPE : EXPLICIT\n"
+                             << "EDGE_WEIGHT_FORMAT : FULL_MATRIX\n"
+                             << "EDGE_WEIGHT_SECTION\n0\n";
+    EXPECT_THROW(graph.LoadGraphFromFile(file_name), std::invalid_argument);
+  }
+  graph.SetMemoryLimit(1 << 20);
+  std::ofstream(file_name) << "TYPE : TSP\nDIMENSION : 1000000\n"
+                           << "EDGE_WEIGHT_TYPE : EUC_2D\n"
+                           << "NODE_COORD_SECTION\n1 0 0\n";
+  EXPECT_THROW(graph.LoadGraphFromFile(file_name), std::invalid_argument);
+  EXPECT_EQ(graph.size(), 4);
+}
+
+TEST(Graph, LoadGraphFromEdgeListFile_0) {
+  Graph matrix;
+  matrix.LoadGraphFromFile("samples/matrices/matrices/test_1.txt");
+  Graph graph;
+  graph.LoadGraphFromFile("samples/edge_lists/test_1.edges");
+  EXPECT_EQ(graph.GetRepresentation(), Graph::Representation::kDense);
+  EXPECT_EQ(graph.GetMatrix(), matrix.GetMatrix());
+  EXPECT_EQ(graph.GetNumEdges(), matrix.GetNumEdges());
+  graph.LoadGraphFromEdgeListFile("samples/edge_lists/test_1.edges",
+                                  Graph::Representation::kSparse);
+  EXPECT_EQ(graph.GetRepresentation(), Graph::Representation::kSparse);
+  EXPECT_EQ(graph.GetEdge(7, 5), 2);
+}
+
+TEST(Graph, LoadGraphFromEdgeListFile_parallel) {
+  std::string file_name = "temp.edges";
+  std::ofstream(file_name) << "3 1 7\n1 3 4\n1 3 2\n\n2 1\n";
+  Graph graph;
+  graph.LoadGraphFromFile(file_name);
+  EXPECT_EQ(graph.size(), 3);
+  EXPECT_EQ(graph.GetNumEdges(), 3);
+  EXPECT_EQ(graph.GetEdge(0, 2), 2);
+  EXPECT_EQ(graph.GetEdge(2, 0), 7);
+  EXPECT_EQ(graph.GetEdge(1, 0), 1);
+}
+
+TEST(Graph, LoadGraphFromEdgeListFile_bad) {
+  std::string file_name = "temp.edges";
+  Graph graph;
+  std::ofstream(file_name) << "1 2 3\n0 2 3\n";
+  try {
+    graph.LoadGraphFromFile(file_name);
+    FAIL();
+  } catch (const std::invalid_argument &e) {
+    EXPECT_STREQ(e.what(),
+                 "File read error. Line 2, column 2: vertex numbers start "
+                 "from 1.");
+  }
+  std::ofstream(file_name) << "1 2 0\n";
+  EXPECT_THROW(graph.LoadGraphFromFile(file_name), std::invalid_argument);
+  std::ofstream(file_name) << "1\n";
+  EXPECT_THROW(graph.LoadGraphFromFile(file_name), std::invalid_argument);
+  std::ofstream(file_name) << "# no edges\n";
+  EXPECT_THROW(graph.LoadGraphFromFile(file_name), std::invalid_argument);
+}
+
+TEST(Graph, SetPointSet_implicit) {
+  Graph dense;
+  dense.LoadGraphFromFile("samples/att48_33523.txt");
+  Graph graph;
+  graph.LoadGraphFromTsplibFile("samples/tsplib/att48.tsp",
+                                Graph::Representation::kImplicit);
+  EXPECT_EQ(graph.GetRepresentation(), Graph::Representation::kImplicit);
+  EXPECT_EQ(graph.size(), 48);
+  EXPECT_EQ(graph.GetNumEdges(), 48 * 47);
+  EXPECT_TRUE(graph.GraphOrientationCheck());
+  EXPECT_THROW(graph.GetNeighbours(0), std::logic_error);
+  EXPECT_THROW(graph.GetMatrix(), std::logic_error);
+  for (size_t i = 0; i < 48; ++i) {
+    size_t neighbours = 0;
+    graph.ForEachNeighbour(i, [&](const Graph::Neighbour &neighbour) {
+      EXPECT_EQ(neighbour.weight, dense.GetEdge(i, neighbour.vertex));
+      ++neighbours;
+    });
+    EXPECT_EQ(neighbours, 47);
+  }
+  EXPECT_THROW(graph.LoadGraphFromTsplibFile("samples/tsplib/dantzig42.tsp",
+                                             Graph::Representation::kImplicit),
+               std::invalid_argument);
+}
+
+TEST(Graph, SetDistanceCache_0) {
+  const size_t kCities = 100000;
+  std::mt19937 generator(21);
+  std::uniform_real_distribution<double> coordinate(0.0, 1e6);
+  std::vector<PointSet::Point> points(kCities);
+  for (auto &point : points) {
+    point = {coordinate(generator), coordinate(generator)};
+  }
+  auto point_set = std::make_shared<const PointSet>(
+      std::move(points), PointSet::Metric::kEuclidean);
+  Graph graph;
+  graph.SetMemoryLimit(size_t{256} << 20);
+  graph.SetPointSet(point_set);
+  EXPECT_EQ(graph.GetRepresentation(), Graph::Representation::kImplicit);
+  graph.SetDistanceCache(size_t{64} << 20);
+  EXPECT_THROW(graph.SetDistanceCache(size_t{1} << 30), std::invalid_argument);
+  // the cache counts against the limit of every later load
+  Graph small;
+  small.LoadGraphFromTsplibFile("samples/tsplib/att48.tsp",
+                                Graph::Representation::kImplicit);
+  small.SetMemoryLimit(size_t{1} << 20);
+  small.SetDistanceCache(size_t{1} << 19);
+  auto many_points = std::make_shared<const PointSet>(
+      std::vector<PointSet::Point>(40000), PointSet::Metric::kEuclidean);
+  EXPECT_THROW(small.SetPointSet(many_points, Graph::Representation::kImplicit),
+               std::invalid_argument);
+  EXPECT_EQ(small.size(), 48);
+  small.SetDistanceCache(0);
+  small.SetPointSet(many_points, Graph::Representation::kImplicit);
+  EXPECT_EQ(small.size(), 40000);
+  std::uniform_int_distribution<size_t> vertex(0, kCities - 1);
+  for (size_t i = 0; i < 10000; ++i) {
+    size_t from = vertex(generator);
+    size_t to = i % 2 == 0 ? vertex(generator) : (from + 1) % kCities;
+    size_t distance = point_set->GetDistance(from, to);
+    EXPECT_EQ(graph.GetEdge(from, to), distance);
+    EXPECT_EQ(graph.GetEdge(to, from), distance);
+  }
+}
+
+TEST(Graph, GetNeighbours_0) {
+  Graph graph;
+  std::string file_name = "samples/matrices/matrices/test_1.txt";
+  graph.LoadGraphFromFile(file_name, Graph::Representation::kSparse);
+  Graph::NeighbourRange neighbours = graph.GetNeighbours(1);
+  ASSERT_EQ(neighbours.size(), 4);
+  std::vector<size_t> vertices;
+  std::vector<size_t> weights;
+  for (const auto &neighbour : neighbours) {
+    vertices.push_back(neighbour.vertex);
+    weights.push_back(neighbour.weight);
+  }
+  EXPECT_EQ(vertices, std::vector<size_t>({0, 2, 3, 7}));
+  EXPECT_EQ(weights, std::vector<size_t>({1, 5, 1, 9}));
+  EXPECT_TRUE(graph.GetNeighbours(6).size() == 1);
+}
+
+TEST(Graph, GetReverseNeighbours_0) {
+  Graph graph;
+  graph.LoadGraphFromFile("samples/matrices/matrices/test_1.txt");
+  for (size_t to = 0; to < graph.size(); ++to) {
+    size_t count = 0;
+    size_t previous = 0;
+    for (const auto &neighbour : graph.GetReverseNeighbours(to)) {
+      EXPECT_EQ(graph.GetEdge(neighbour.vertex, to), neighbour.weight);
+      EXPECT_TRUE(count == 0 || previous < neighbour.vertex);
+      previous = neighbour.vertex;
+      ++count;
+    }
+    size_t expected = 0;
+    for (size_t from = 0; from < graph.size(); ++from) {
+      expected += graph.GetEdge(from, to) != 0;
+    }
+    EXPECT_EQ(count, expected);
+  }
+  Graph copy = graph;
+  EXPECT_EQ(copy.GetReverseNeighbours(0).begin(),
+            graph.GetReverseNeighbours(0).begin());
+  graph.LoadGraphFromFile("samples/graph_4.adj");
+  EXPECT_EQ(graph.GetReverseNeighbours(1).begin(),
+            graph.GetNeighbours(1).begin());
+}
+
+TEST(Graph, ExportGraphToDot_sparse) {
+  Graph graph;
+  std::string file_name = "samples/graph_4_orient.adj";
+  graph.LoadGraphFromFile(file_name, Graph::Representation::kSparse);
+  graph.ExportGraphToDot("temp");
+  EXPECT_TRUE(CompareFiles("temp.dot", "samples/graph_4_orient.dot"));
+}
+
 TEST(Graph, ExportGraphToDot_0) {
   Graph graph;
   std::string file_name = "samples/graph_4.adj";
@@ -139,6 +485,77 @@ TEST(Graph, ExportGraphToDot_bad) {
   EXPECT_ANY_THROW(graph.ExportGraphToDot(""));
 }
 
+TEST(Graph, ExportGraphToBinary_0) {
+  Graph graph;
+  std::string file_name = "samples/matrices/matrices/test_1.txt";
+  graph.LoadGraphFromFile(file_name);
+  graph.ExportGraphToBinary("temp");
+  Graph mapped;
+  mapped.LoadGraphFromFile("temp.bin");
+  EXPECT_EQ(mapped.GetRepresentation(), Graph::Representation::kSparse);
+  EXPECT_EQ(mapped.size(), graph.size());
+  EXPECT_EQ(mapped.GetNumEdges(), graph.GetNumEdges());
+  for (size_t i = 0; i < graph.size(); ++i) {
+    for (size_t j = 0; j < graph.size(); ++j) {
+      EXPECT_EQ(mapped.GetEdge(i, j), graph.GetEdge(i, j));
+    }
+  }
+  EXPECT_EQ(GraphAlgorithms::DepthFirstSearch(mapped, 1),
+            GraphAlgorithms::DepthFirstSearch(graph, 1));
+
+  Graph copy = mapped;
+  mapped.LoadGraphFromFile(file_name);
+  EXPECT_EQ(copy.GetEdge(1, 7), 9);
+
+  Graph dense;
+  dense.LoadGraphFromFile("temp.bin", Graph::Representation::kDense);
+  EXPECT_EQ(dense.GetMatrix(), graph.GetMatrix());
+}
+
+TEST(Graph, ExportGraphToBinary_bad) {
+  Graph graph;
+  graph.LoadGraphFromFile("samples/graph_4.adj");
+  EXPECT_ANY_THROW(graph.ExportGraphToBinary(""));
+  graph.ExportGraphToBinary("temp");
+  {
+    std::fstream file("temp.bin",
+                      std::ios::in | std::ios::out | std::ios::binary);
+    file.seekp(16);
+    file.write("\xff\xff\xff\xff", 4);
+  }
+  EXPECT_ANY_THROW(graph.LoadGraphFromFile("temp.bin"));
+  EXPECT_EQ(graph.size(), 4);
+}
+
+TEST(Graph, ExportGraphToBinary_corrupted_arrays) {
+  Graph graph;
+  graph.LoadGraphFromFile("samples/graph_4.adj");
+  graph.ExportGraphToBinary("temp");
+  BinaryGraphFile::Header header;
+  {
+    std::ifstream file("temp.bin", std::ios::binary);
+    file.read(reinterpret_cast<char *>(&header), sizeof(header));
+  }
+  auto corrupt = [&](uint64_t position, uint64_t value) {
+    graph.ExportGraphToBinary("temp");
+    std::fstream file("temp.bin",
+                      std::ios::in | std::ios::out | std::ios::binary);
+    file.seekp(position);
+    file.write(reinterpret_cast<const char *>(&value), sizeof(value));
+  };
+  Graph loaded;
+  // target out of range, row out of order, zero weight
+  corrupt(header.vertices_position, 4);
+  EXPECT_THROW(loaded.LoadGraphFromFile("temp.bin"), std::invalid_argument);
+  corrupt(header.vertices_position + sizeof(uint64_t), 0);
+  EXPECT_THROW(loaded.LoadGraphFromFile("temp.bin"), std::invalid_argument);
+  corrupt(header.weights_position, 0);
+  EXPECT_THROW(loaded.LoadGraphFromFile("temp.bin"), std::invalid_argument);
+  graph.ExportGraphToBinary("temp");
+  loaded.LoadGraphFromFile("temp.bin");
+  EXPECT_EQ(loaded.GetNumEdges(), graph.GetNumEdges());
+}
+
 TEST(GraphAlgorithms, BFS_0) {
   Graph graph;
   std::string file_name = "samples/matrices/matrices/test_wiki.txt";
@@ -343,6 +760,525 @@ TEST(GraphAlgorithms, SPBV_9) {
       GraphAlgorithms::GetShortestPathBetweenVertices(graph, 1, 11));
 }
 
+TEST(GraphAlgorithms, GetShortestPath_0) {
+  std::vector<std::string> file_name_list = {
+      "samples/matrices/matrices/test_1.txt",
+      "samples/matrices/matrices/orie.txt", "samples/graph_11.adj"};
+  for (auto &file_name : file_name_list) {
+    Graph graph;
+    graph.LoadGraphFromFile(file_name);
+    int size = graph.size();
+    for (int i = 1; i <= size; ++i) {
+      for (int j = 1; j <= size; ++j) {
+        GraphAlgorithms::PathResult path =
+            GraphAlgorithms::GetShortestPath(graph, i, j);
+        EXPECT_EQ(path.distance,
+                  GraphAlgorithms::GetShortestPathBetweenVertices(graph, i, j));
+        if (path.vertices.empty()) {
+          EXPECT_EQ(path.distance, std::numeric_limits<size_t>::max());
+          continue;
+        }
+        EXPECT_EQ(path.vertices.front(), i);
+        EXPECT_EQ(path.vertices.back(), j);
+        size_t length = 0;
+        for (size_t k = 0; k + 1 < path.vertices.size(); ++k) {
+          size_t weight =
+              graph.GetEdge(path.vertices[k] - 1, path.vertices[k + 1] - 1);
+          EXPECT_NE(weight, 0);
+          length += weight;
+        }
+        EXPECT_EQ(length, path.distance);
+      }
+    }
+  }
+}
+
+TEST(GraphAlgorithms, GetShortestPath_1) {
+  Graph graph;
+  graph.LoadGraphFromFile("samples/matrices/matrices/test_1.txt");
+  GraphAlgorithms::PathResult path =
+      GraphAlgorithms::GetShortestPath(graph, 7, 2);
+  GraphAlgorithms::ResultArray expected{7, 1, 5, 4, 2};
+  EXPECT_EQ(path.vertices, expected);
+  EXPECT_EQ(path.distance, 8);
+  path = GraphAlgorithms::GetShortestPath(graph, 3, 3);
+  EXPECT_EQ(path.vertices, GraphAlgorithms::ResultArray{3});
+  EXPECT_EQ(path.distance, 0);
+  EXPECT_THROW(GraphAlgorithms::GetShortestPath(graph, 0, 3),
+               std::invalid_argument);
+}
+
+TEST(GraphAlgorithms, GetShortestPath_bidirectional) {
+  std::vector<std::string> file_name_list = {
+      "samples/matrices/matrices/test_1.txt",
+      "samples/matrices/matrices/orie.txt", "samples/graph_4_orient.adj",
+      "samples/graph_11.adj"};
+  auto kBidirectional = GraphAlgorithms::PathStrategy::kBidirectional;
+  for (auto &file_name : file_name_list) {
+    Graph graph;
+    graph.LoadGraphFromFile(file_name, Graph::Representation::kSparse);
+    int size = graph.size();
+    for (int i = 1; i <= size; ++i) {
+      for (int j = 1; j <= size; ++j) {
+        GraphAlgorithms::PathResult path =
+            GraphAlgorithms::GetShortestPath(graph, i, j, kBidirectional);
+        EXPECT_EQ(path.distance,
+                  GraphAlgorithms::GetShortestPathBetweenVertices(graph, i, j));
+        EXPECT_EQ(path.distance,
+                  GraphAlgorithms::GetShortestPathBetweenVertices(
+                      graph, i, j, kBidirectional));
+        if (path.vertices.empty()) continue;
+        EXPECT_EQ(path.vertices.front(), i);
+        EXPECT_EQ(path.vertices.back(), j);
+        size_t length = 0;
+        for (size_t k = 0; k + 1 < path.vertices.size(); ++k) {
+          size_t weight =
+              graph.GetEdge(path.vertices[k] - 1, path.vertices[k + 1] - 1);
+          EXPECT_NE(weight, 0);
+          length += weight;
+        }
+        EXPECT_EQ(length, path.distance);
+      }
+    }
+  }
+}
+
+TEST(GraphAlgorithms, GetShortestPath_bidirectional_large) {
+  std::string file_name = "temp_ring.adj";
+  WriteRingGraph(file_name, 2000);
+  Graph graph;
+  graph.LoadGraphFromFile(file_name, Graph::Representation::kSparse);
+  auto kBidirectional = GraphAlgorithms::PathStrategy::kBidirectional;
+  for (int i = 1; i <= 2000; i += 97) {
+    for (int j = 1; j <= 2000; j += 131) {
+      EXPECT_EQ(
+          GraphAlgorithms::GetShortestPathBetweenVertices(graph, i, j),
+          GraphAlgorithms::GetShortestPathBetweenVertices(graph, i, j,
+                                                          kBidirectional));
+    }
+  }
+}
+
+TEST(GraphAlgorithms, ContractionHierarchy_0) {
+  std::vector<std::string> file_name_list = {
+      "samples/matrices/matrices/test_1.txt",
+      "samples/matrices/matrices/orie.txt", "samples/graph_4_orient.adj",
+      "samples/graph_11.adj", "samples/dantzig42_699.adj.txt"};
+  for (auto &file_name : file_name_list) {
+    Graph graph;
+    graph.LoadGraphFromFile(file_name);
+    ContractionHierarchy hierarchy =
+        GraphAlgorithms::BuildContractionHierarchy(graph);
+    int size = graph.size();
+    for (int i = 1; i <= size; ++i) {
+      for (int j = 1; j <= size; ++j) {
+        size_t expected =
+            GraphAlgorithms::GetShortestPathBetweenVertices(graph, i, j);
+        EXPECT_EQ(
+            GraphAlgorithms::GetShortestPathBetweenVertices(hierarchy, i, j),
+            expected);
+        GraphAlgorithms::PathResult path =
+            GraphAlgorithms::GetShortestPath(hierarchy, i, j);
+        EXPECT_EQ(path.distance, expected);
+        if (path.vertices.empty()) continue;
+        EXPECT_EQ(path.vertices.front(), i);
+        EXPECT_EQ(path.vertices.back(), j);
+        size_t length = 0;
+        for (size_t k = 0; k + 1 < path.vertices.size(); ++k) {
+          size_t weight =
+              graph.GetEdge(path.vertices[k] - 1, path.vertices[k + 1] - 1);
+          EXPECT_NE(weight, 0);
+          length += weight;
+        }
+        EXPECT_EQ(length, expected);
+      }
+    }
+  }
+}
+
+TEST(GraphAlgorithms, ContractionHierarchy_save) {
+  std::string file_name = "temp_ring.adj";
+  WriteRingGraph(file_name, 1000);
+  Graph graph;
+  graph.LoadGraphFromFile(file_name, Graph::Representation::kSparse);
+  ContractionHierarchy hierarchy(graph);
+  hierarchy.Save("temp.ch");
+  ContractionHierarchy loaded = ContractionHierarchy::Load("temp.ch");
+  EXPECT_EQ(loaded.GetNumVertices(), 1000);
+  EXPECT_EQ(loaded.GetNumShortcuts(), hierarchy.GetNumShortcuts());
+  for (int i = 1; i <= 1000; i += 37) {
+    for (int j = 1; j <= 1000; j += 53) {
+      EXPECT_EQ(GraphAlgorithms::GetShortestPath(loaded, i, j).distance,
+                GraphAlgorithms::GetShortestPathBetweenVertices(graph, i, j));
+    }
+  }
+  EXPECT_THROW(ContractionHierarchy::Load("samples/graph_4.adj"),
+               std::invalid_argument);
+  std::ofstream("temp.ch", std::ios::binary | std::ios::app) << "x";
+  EXPECT_THROW(ContractionHierarchy::Load("temp.ch"), std::invalid_argument);
+  EXPECT_THROW(GraphAlgorithms::GetShortestPath(loaded, 1, 1001),
+               std::invalid_argument);
+}
+
+TEST(GraphAlgorithms, GetShortestPath_cache) {
+  Graph graph;
+  graph.LoadGraphFromFile("samples/matrices/matrices/test_1.txt");
+  EXPECT_EQ(graph.GetShortestPathCache(), nullptr);
+  // room for two trees of 10 vertices
+  graph.SetShortestPathCache(2 * 2 * 10 * sizeof(size_t));
+  ShortestPathCache *cache = graph.GetShortestPathCache();
+  ASSERT_NE(cache, nullptr);
+  GraphAlgorithms::PathResult path = GraphAlgorithms::GetShortestPath(
+      graph, 7, 2);
+  EXPECT_EQ(path.vertices, std::vector<size_t>({7, 1, 5, 4, 2}));
+  EXPECT_EQ(path.distance, 8);
+  EXPECT_EQ(GraphAlgorithms::GetShortestPathBetweenVertices(graph, 7, 2), 8);
+  EXPECT_EQ(cache->GetMisses(), 1);
+  EXPECT_EQ(cache->GetHits(), 1);
+  GraphAlgorithms::GetShortestPathBetweenVertices(graph, 1, 2);
+  GraphAlgorithms::GetShortestPathBetweenVertices(graph, 7, 3);
+  GraphAlgorithms::GetShortestPathBetweenVertices(graph, 3, 2);
+  // 1 was the least recently used tree
+  EXPECT_EQ(cache->GetNumTrees(), 2);
+  EXPECT_EQ(cache->GetBytes(), cache->GetCapacity());
+  EXPECT_EQ(cache->GetHits(), 2);
+  GraphAlgorithms::GetShortestPathBetweenVertices(graph, 1, 2);
+  EXPECT_EQ(cache->GetMisses(), 4);
+  using Strategy = GraphAlgorithms::PathStrategy;
+  for (int i = 1; i <= 10; ++i) {
+    for (int j = 1; j <= 10; ++j) {
+      EXPECT_EQ(GraphAlgorithms::GetShortestPathBetweenVertices(graph, i, j),
+                GraphAlgorithms::GetShortestPathBetweenVertices(
+                    graph, i, j, Strategy::kBidirectional));
+    }
+  }
+  // too small for one tree: the query runs the search that stops at its
+  // target instead of a complete one the cache would drop
+  graph.SetShortestPathCache(2 * 10 * sizeof(size_t) - 1);
+  cache = graph.GetShortestPathCache();
+  EXPECT_FALSE(cache->CanHold(graph.size()));
+  EXPECT_TRUE(cache->CanHold(graph.size() - 1));
+  path = GraphAlgorithms::GetShortestPath(graph, 7, 2);
+  EXPECT_EQ(path.vertices, std::vector<size_t>({7, 1, 5, 4, 2}));
+  EXPECT_EQ(GraphAlgorithms::GetShortestPathBetweenVertices(graph, 7, 2), 8);
+  EXPECT_EQ(cache->GetMisses(), 0);
+  EXPECT_EQ(cache->GetNumTrees(), 0);
+  graph.LoadGraphFromFile("samples/graph_4.adj");
+  ASSERT_NE(graph.GetShortestPathCache(), nullptr);
+  EXPECT_EQ(graph.GetShortestPathCache()->GetNumTrees(), 0);
+  graph.SetShortestPathCache(0);
+  EXPECT_EQ(graph.GetShortestPathCache(), nullptr);
+  graph.SetMemoryLimit(1024);
+  EXPECT_THROW(graph.SetShortestPathCache(1024), std::invalid_argument);
+}
+
+TEST(GraphAlgorithms, GetShortestPath_landmarks) {
+  Graph graph;
+  graph.LoadGraphFromFile("samples/matrices/matrices/test_11.txt");
+  LandmarkHeuristic heuristic =
+      GraphAlgorithms::BuildLandmarkHeuristic(graph, 2);
+  EXPECT_EQ(heuristic.GetLandmarks().size(), 2);
+  for (int i = 1; i <= 5; ++i) {
+    for (int j = 1; j <= 5; ++j) {
+      size_t expected = GraphAlgorithms::GetShortestPathBetweenVertices(
+          graph, i, j);
+      EXPECT_LE(heuristic.Estimate(i - 1, j - 1), expected);
+      GraphAlgorithms::PathResult path =
+          GraphAlgorithms::GetShortestPath(graph, i, j, heuristic);
+      EXPECT_EQ(path.distance, expected);
+      EXPECT_EQ(path.vertices.front(), i);
+      EXPECT_EQ(path.vertices.back(), j);
+    }
+  }
+  Graph other;
+  other.LoadGraphFromFile("samples/graph_4.adj");
+  EXPECT_THROW(GraphAlgorithms::GetShortestPath(other, 1, 2, heuristic),
+               std::invalid_argument);
+}
+
+TEST(GraphAlgorithms, GetShortestPath_landmarks_large) {
+  std::string file_name = "temp_ring.adj";
+  WriteRingGraph(file_name, 1000);
+  Graph graph;
+  graph.LoadGraphFromFile(file_name, Graph::Representation::kSparse);
+  LandmarkHeuristic heuristic(graph);
+  for (int i = 1; i <= 1000; i += 37) {
+    for (int j = 1; j <= 1000; j += 53) {
+      EXPECT_EQ(
+          GraphAlgorithms::GetShortestPathBetweenVertices(graph, i, j,
+                                                          heuristic),
+          GraphAlgorithms::GetShortestPathBetweenVertices(graph, i, j));
+    }
+  }
+}
+
+TEST(GraphAlgorithms, GetShortestPath_coordinates) {
+  Graph graph;
+  graph.LoadGraphFromFile("samples/tsplib/att48.tsp",
+                          Graph::Representation::kImplicit);
+  CoordinateHeuristic heuristic(graph.GetPointSet());
+  GraphAlgorithms::PathResult path =
+      GraphAlgorithms::GetShortestPath(graph, 1, 48, heuristic);
+  EXPECT_EQ(path.distance, graph.GetEdge(0, 47));
+  EXPECT_EQ(path.vertices, std::vector<size_t>({1, 48}));
+  Graph adjacency;
+  adjacency.LoadGraphFromFile("samples/graph_4.adj");
+  EXPECT_THROW(CoordinateHeuristic(adjacency.GetPointSet()),
+               std::invalid_argument);
+  PointSet geo({{0, 0}, {1, 1}}, PointSet::Metric::kGeo);
+  EXPECT_THROW(CoordinateHeuristic heuristic(&geo), std::invalid_argument);
+}
+
+TEST(GraphAlgorithms, GetShortestPath_coordinates_sparse) {
+  // Edges to the few nearest cities only, weighted by the metric. Short
+  // edges round down the most, and ATT weights are about a third of the
+  // coordinate distance, so a bound off by either loses shortest paths.
+  const size_t kCities = 200;
+  std::mt19937 generator(11);
+  for (auto [metric, range] :
+       {std::pair(PointSet::Metric::kEuclidean, 15.0),
+        std::pair(PointSet::Metric::kCeilEuclidean, 1000.0),
+        std::pair(PointSet::Metric::kPseudoEuclidean, 10000.0)}) {
+    std::uniform_real_distribution<double> coordinate(0.0, range);
+    std::vector<PointSet::Point> points(kCities);
+    for (auto &point : points) {
+      point = {coordinate(generator), coordinate(generator)};
+    }
+    PointSet point_set(points, metric);
+    std::ofstream file("temp_random.edges");
+    for (size_t i = 0; i < kCities; ++i) {
+      std::vector<std::pair<size_t, size_t>> row;
+      for (size_t j = 0; j < kCities; ++j) {
+        size_t weight = point_set.GetDistance(i, j);
+        if (weight != 0) row.push_back({weight, j});
+      }
+      std::partial_sort(row.begin(), row.begin() + 4, row.end());
+      for (size_t k = 0; k < 4; ++k) {
+        file << i + 1 << " " << row[k].second + 1 << " " << row[k].first
+             << "\n" << row[k].second + 1 << " " << i + 1 << " "
+             << row[k].first << "\n";
+      }
+    }
+    file.close();
+    Graph graph;
+    graph.LoadGraphFromFile("temp_random.edges");
+    CoordinateHeuristic heuristic(&point_set);
+    for (int target = 2; target <= (int)kCities; target += 3) {
+      EXPECT_EQ(GraphAlgorithms::GetShortestPathBetweenVertices(
+                    graph, 1, target, heuristic),
+                GraphAlgorithms::GetShortestPathBetweenVertices(graph, 1,
+                                                                target));
+    }
+  }
+}
+
+TEST(GraphAlgorithms, SPBAV_blocked) {
+  // spans two tiles of FloydWarshall; the last vertex has no edges in
+  const size_t size = FloydWarshall::kBlockSize + 45;
+  std::mt19937 generator(7);
+  std::uniform_int_distribution<size_t> weight(0, 30);
+  std::vector<Graph::Edge> edges;
+  for (size_t i = 0; i + 1 < size; ++i) {
+    for (size_t j = 0; j + 1 < size; ++j) {
+      size_t w = weight(generator);
+      if (i != j && w <= 3) edges.push_back({i, j, w * 100 + i % 7 + 1});
+    }
+  }
+  std::ofstream file("temp_random.edges");
+  for (const auto &edge : edges) {
+    file << edge.from + 1 << " " << edge.to + 1 << " " << edge.weight << "\n";
+  }
+  file << size << " " << size - 1 << " 1\n";
+  file.close();
+  Graph graph;
+  graph.LoadGraphFromFile("temp_random.edges");
+  Graph::AdjacencyMatrix matrix =
+      GraphAlgorithms::GetShortestPathsBetweenAllVertices(graph);
+  for (size_t i = 0; i < size; i += 13) {
+    for (size_t j = 0; j < size; ++j) {
+      EXPECT_EQ(matrix(i, j), GraphAlgorithms::GetShortestPathBetweenVertices(
+                                  graph, i + 1, j + 1));
+    }
+  }
+  EXPECT_EQ(matrix(0, size - 1), std::numeric_limits<size_t>::max());
+  EXPECT_EQ(matrix(size - 1, size - 1), 0);
+}
+
+TEST(GraphAlgorithms, SPBAV_parallel) {
+  std::string file_name = "temp_ring.adj";
+  WriteRingGraph(file_name, 600);
+  Graph graph;
+  graph.LoadGraphFromFile(file_name);
+  using Strategy = GraphAlgorithms::AllPairsStrategy;
+  Graph::AdjacencyMatrix expected =
+      GraphAlgorithms::GetShortestPathsBetweenAllVertices(
+          graph, Strategy::kFloydWarshall, 1);
+  EXPECT_EQ(expected(0, 300), 300 * 301 / 2);
+  for (Strategy strategy : {Strategy::kAuto, Strategy::kFloydWarshall,
+                            Strategy::kDijkstra}) {
+    EXPECT_EQ(GraphAlgorithms::GetShortestPathsBetweenAllVertices(
+                  graph, strategy, 4),
+              expected);
+  }
+  std::ofstream("temp_random.edges") << "1 1 5\n1 2 3\n2 3 4\n3 3 7\n";
+  Graph loops;
+  loops.LoadGraphFromFile("temp_random.edges");
+  Graph::AdjacencyMatrix floyd =
+      GraphAlgorithms::GetShortestPathsBetweenAllVertices(
+          loops, Strategy::kFloydWarshall);
+  EXPECT_EQ(floyd, GraphAlgorithms::GetShortestPathsBetweenAllVertices(
+                       loops, Strategy::kDijkstra));
+  EXPECT_EQ(floyd(0, 0), 0);
+  EXPECT_EQ(floyd(2, 2), 0);
+  EXPECT_EQ(floyd(0, 2), 7);
+  Graph implicit;
+  implicit.LoadGraphFromFile("samples/tsplib/att48.tsp",
+                             Graph::Representation::kImplicit);
+  Graph::AdjacencyMatrix distances =
+      GraphAlgorithms::GetShortestPathsBetweenAllVertices(implicit);
+  EXPECT_EQ(distances(0, 47), implicit.GetEdge(0, 47));
+  EXPECT_EQ(GraphAlgorithms::GetShortestPathsBetweenAllVertices(
+                implicit, Strategy::kDijkstra),
+            distances);
+}
+
+TEST(GraphAlgorithms, SPBAV_stream) {
+  std::string file_name = "temp_ring.adj";
+  WriteRingGraph(file_name, 100);
+  Graph graph;
+  graph.LoadGraphFromFile(file_name);
+  Graph::AdjacencyMatrix expected =
+      GraphAlgorithms::GetShortestPathsBetweenAllVertices(graph);
+  using Strategy = GraphAlgorithms::AllPairsStrategy;
+  for (Strategy strategy : {Strategy::kFloydWarshall, Strategy::kDijkstra}) {
+    DistanceMatrixFile::Writer writer("temp_distances.bin", 100, 100);
+    size_t next_row = 0;
+    GraphAlgorithms::StreamShortestPathsBetweenAllVertices(
+        graph,
+        [&](size_t first_row, const Graph::AdjacencyMatrix &block) {
+          EXPECT_EQ(first_row, next_row);
+          EXPECT_LE(block.GetRows(), 30);
+          next_row += block.GetRows();
+          writer.WriteRows(first_row, block);
+        },
+        strategy, 2, 30);
+    EXPECT_EQ(next_row, 100);
+    EXPECT_EQ(DistanceMatrixFile::Read("temp_distances.bin"), expected);
+  }
+  DistanceMatrixFile::Writer writer("temp_distances.bin", 100, 100);
+  EXPECT_THROW(writer.WriteRows(90, expected), std::out_of_range);
+  EXPECT_THROW(DistanceMatrixFile::Read("samples/graph_4.adj"),
+               std::invalid_argument);
+  std::ofstream("temp_distances.bin", std::ios::binary | std::ios::app) << "x";
+  EXPECT_THROW(DistanceMatrixFile::Read("temp_distances.bin"),
+               std::invalid_argument);
+  // an empty graph streams no blocks, as its matrix has no rows
+  Graph empty;
+  for (Strategy strategy :
+       {Strategy::kAuto, Strategy::kFloydWarshall, Strategy::kDijkstra}) {
+    size_t num_blocks = 0;
+    GraphAlgorithms::StreamShortestPathsBetweenAllVertices(
+        empty, [&](size_t, const Graph::AdjacencyMatrix &) { ++num_blocks; },
+        strategy);
+    EXPECT_EQ(num_blocks, 0);
+  }
+  EXPECT_EQ(GraphAlgorithms::GetShortestPathsBetweenAllVertices(empty)
+                .GetRows(),
+            0);
+}
+
+TEST(GraphAlgorithms, SPBAV_johnson) {
+  SignedGraph graph;
+  graph.LoadGraphFromFile("samples/edge_lists/johnson.edges");
+  EXPECT_EQ(graph.size(), 5);
+  EXPECT_EQ(graph.GetNumEdges(), 9);
+  SignedGraph::DistanceMatrix expected = {{0, 1, -3, 2, -4},
+                                          {3, 0, -4, 1, -1},
+                                          {7, 4, 0, 5, 3},
+                                          {2, -1, -5, 0, -2},
+                                          {8, 5, 1, 6, 0}};
+  EXPECT_EQ(GraphAlgorithms::GetShortestPathsBetweenAllVertices(graph),
+            expected);
+  Graph unsigned_graph;
+  unsigned_graph.LoadGraphFromFile("samples/edge_lists/test_1.edges");
+  SignedGraph::DistanceMatrix distances =
+      GraphAlgorithms::GetShortestPathsBetweenAllVertices(
+          SignedGraph(unsigned_graph), 2);
+  Graph::AdjacencyMatrix unsigned_distances =
+      GraphAlgorithms::GetShortestPathsBetweenAllVertices(unsigned_graph);
+  for (size_t i = 0; i < unsigned_graph.size(); ++i) {
+    for (size_t j = 0; j < unsigned_graph.size(); ++j) {
+      if (unsigned_distances(i, j) == std::numeric_limits<size_t>::max()) {
+        EXPECT_EQ(distances(i, j), SignedGraph::kUnreachable);
+      } else {
+        EXPECT_EQ(distances(i, j), (int64_t)unsigned_distances(i, j));
+      }
+    }
+  }
+}
+
+TEST(GraphAlgorithms, SPBAV_negative_cycle) {
+  SignedGraph graph;
+  graph.LoadGraphFromFile("samples/edge_lists/negative_cycle.edges");
+  try {
+    GraphAlgorithms::GetShortestPathsBetweenAllVertices(graph);
+    FAIL() << "NegativeCycleError expected";
+  } catch (const NegativeCycleError &e) {
+    std::vector<size_t> cycle = e.GetCycle();
+    std::rotate(cycle.begin(),
+                std::min_element(cycle.begin(), cycle.end()), cycle.end());
+    EXPECT_EQ(cycle, std::vector<size_t>({2, 3, 4}));
+    EXPECT_NE(std::string(e.what()).find("negative cycle"),
+              std::string::npos);
+  }
+  SignedGraph loop(1, {{0, 0, -1}});
+  EXPECT_THROW(GraphAlgorithms::GetShortestPathsBetweenAllVertices(loop),
+               NegativeCycleError);
+  EXPECT_THROW(SignedGraph(2, {{0, 2, 1}}), std::out_of_range);
+  EXPECT_THROW(graph.LoadGraphFromFile("samples/graph_4.adj"),
+               std::invalid_argument);
+}
+
+TEST(GraphAlgorithms, GetDistanceTable_0) {
+  std::string file_name = "temp_ring.adj";
+  WriteRingGraph(file_name, 300);
+  Graph graph;
+  graph.LoadGraphFromFile(file_name, Graph::Representation::kSparse);
+  ContractionHierarchy hierarchy(graph);
+  GraphAlgorithms::ResultArray sources = {1, 50, 300, 50};
+  GraphAlgorithms::ResultArray targets = {2, 150, 1, 299, 150, 77};
+  Graph::AdjacencyMatrix table =
+      GraphAlgorithms::GetDistanceTable(graph, sources, targets, 2);
+  ASSERT_EQ(table.GetRows(), sources.size());
+  ASSERT_EQ(table.GetCols(), targets.size());
+  for (size_t i = 0; i < sources.size(); ++i) {
+    for (size_t j = 0; j < targets.size(); ++j) {
+      EXPECT_EQ(table(i, j), GraphAlgorithms::GetShortestPathBetweenVertices(
+                                 graph, sources[i], targets[j]));
+    }
+  }
+  EXPECT_EQ(GraphAlgorithms::GetDistanceTable(hierarchy, sources, targets, 3),
+            table);
+  EXPECT_THROW(GraphAlgorithms::GetDistanceTable(graph, {1}, {301}),
+               std::invalid_argument);
+  EXPECT_THROW(GraphAlgorithms::GetDistanceTable(hierarchy, {0}, {1}),
+               std::invalid_argument);
+}
+
+TEST(GraphAlgorithms, GetDistanceTable_unreachable) {
+  Graph graph;
+  graph.LoadGraphFromFile("samples/edge_lists/test_1.edges");
+  GraphAlgorithms::ResultArray all(graph.size());
+  std::iota(all.begin(), all.end(), 1);
+  Graph::AdjacencyMatrix table =
+      GraphAlgorithms::GetDistanceTable(graph, all, all);
+  EXPECT_EQ(table,
+            GraphAlgorithms::GetShortestPathsBetweenAllVertices(graph));
+  EXPECT_EQ(GraphAlgorithms::GetDistanceTable(ContractionHierarchy(graph),
+                                              all, all),
+            table);
+}
+
 TEST(GraphAlgorithms, SPBAV_0) {
   Graph graph;
   std::string file_name = "samples/matrices/matrices/test_11.txt";
@@ -396,6 +1332,33 @@ TEST(GraphAlgorithms, SPBAV_VS_SPBV) {
   }
 }
 
+TEST(GraphAlgorithms, sparse_VS_dense) {
+  std::vector<std::string> file_name_list = {
+      "samples/matrices/matrices/test_1.txt",
+      "samples/matrices/matrices/test_wiki.txt",
+      "samples/matrices/matrices/orie.txt", "samples/graph_11.adj"};
+  for (auto &file_name : file_name_list) {
+    Graph dense;
+    Graph sparse;
+    dense.LoadGraphFromFile(file_name);
+    sparse.LoadGraphFromFile(file_name, Graph::Representation::kSparse);
+    size_t size = dense.size();
+    for (size_t i = 1; i <= size; ++i) {
+      EXPECT_EQ(GraphAlgorithms::BreadthFirstSearch(sparse, i),
+                GraphAlgorithms::BreadthFirstSearch(dense, i));
+      EXPECT_EQ(GraphAlgorithms::DepthFirstSearch(sparse, i),
+                GraphAlgorithms::DepthFirstSearch(dense, i));
+      for (size_t j = 1; j <= size; ++j) {
+        EXPECT_EQ(
+            GraphAlgorithms::GetShortestPathBetweenVertices(sparse, i, j),
+            GraphAlgorithms::GetShortestPathBetweenVertices(dense, i, j));
+      }
+    }
+    EXPECT_EQ(GraphAlgorithms::GetShortestPathsBetweenAllVertices(sparse),
+              GraphAlgorithms::GetShortestPathsBetweenAllVertices(dense));
+  }
+}
+
 TEST(GraphAlgorithms, GLST_0) {
   Graph graph;
   std::string file_name = "samples/graph_4.adj";
@@ -412,6 +1375,104 @@ TEST(GraphAlgorithms, GLST_0) {
   }
 }
 
+TEST(GraphAlgorithms, GetMinimumSpanningTree_0) {
+  Graph graph;
+  graph.LoadGraphFromFile("samples/graph_4.adj");
+  GraphAlgorithms::SpanningTreeResult tree =
+      GraphAlgorithms::GetMinimumSpanningTree(graph);
+  EXPECT_EQ(tree.weight, 50);
+  EXPECT_EQ(tree.num_components, 1);
+  ASSERT_EQ(tree.edges.size(), 3);
+  EXPECT_EQ(tree.edges[0].from, 2);
+  EXPECT_EQ(tree.edges[0].to, 3);
+  EXPECT_EQ(tree.edges[1].from, 3);
+  EXPECT_EQ(tree.edges[1].to, 4);
+  EXPECT_EQ(tree.edges[2].from, 1);
+  EXPECT_EQ(tree.edges[2].to, 3);
+  Graph oriented;
+  oriented.LoadGraphFromFile("samples/graph_4_orient.adj");
+  EXPECT_THROW(GraphAlgorithms::GetMinimumSpanningTree(oriented),
+               std::invalid_argument);
+}
+
+TEST(GraphAlgorithms, GetMinimumSpanningTree_forest) {
+  using Strategy = GraphAlgorithms::SpanningTreeStrategy;
+  Graph graph;
+  graph.LoadGraphFromFile("samples/graph_forest.adj");
+  for (Strategy strategy :
+       {Strategy::kKruskal, Strategy::kBoruvka, Strategy::kPrim}) {
+    GraphAlgorithms::SpanningTreeResult forest =
+        GraphAlgorithms::GetMinimumSpanningTree(graph, strategy);
+    EXPECT_EQ(forest.num_components, 4);
+    EXPECT_EQ(forest.weight, 18);
+    ASSERT_EQ(forest.edges.size(), 4);
+    EXPECT_EQ(forest.edges[0].from, 2);
+    EXPECT_EQ(forest.edges[0].to, 3);
+    EXPECT_EQ(forest.edges[3].from, 4);
+    EXPECT_EQ(forest.edges[3].to, 5);
+  }
+  Graph::AdjacencyMatrix matrix = GraphAlgorithms::GetLeastSpanningTree(graph);
+  size_t sum = 0;
+  for (size_t i = 0; i < graph.size(); ++i) {
+    for (size_t j = 0; j < graph.size(); ++j) sum += matrix(i, j);
+  }
+  EXPECT_EQ(sum, 2 * 18);
+  EXPECT_EQ(matrix(7, 7), 0);
+  EXPECT_EQ(matrix(0, 0), 0);
+}
+
+TEST(GraphAlgorithms, GetMinimumSpanningTree_random) {
+  const size_t size = 300;
+  std::mt19937 generator(11);
+  std::uniform_int_distribution<size_t> weight(1, 50);
+  Graph::AdjacencyMatrix matrix(size, size);
+  for (size_t i = 0; i < size; ++i) {
+    for (size_t j = i + 1; j < size; ++j) {
+      if (weight(generator) <= 10 || j == i + 1) {
+        matrix(i, j) = matrix(j, i) = weight(generator);
+      }
+    }
+  }
+  std::ofstream file("temp_random.adj");
+  file << size << std::endl;
+  for (size_t i = 0; i < size; ++i) {
+    for (size_t j = 0; j < size; ++j) file << matrix(i, j) << " ";
+    file << std::endl;
+  }
+  file.close();
+  Graph graph;
+  graph.LoadGraphFromFile("temp_random.adj");
+  // reference: O(V^2) Prim over the matrix
+  std::vector<size_t> best(size, std::numeric_limits<size_t>::max());
+  std::vector<bool> in_tree(size, false);
+  best[0] = 0;
+  size_t expected = 0;
+  for (size_t step = 0; step < size; ++step) {
+    size_t next = size;
+    for (size_t v = 0; v < size; ++v) {
+      if (!in_tree[v] && (next == size || best[v] < best[next])) next = v;
+    }
+    in_tree[next] = true;
+    expected += best[next];
+    for (size_t v = 0; v < size; ++v) {
+      if (matrix(next, v) != 0 && matrix(next, v) < best[v]) {
+        best[v] = matrix(next, v);
+      }
+    }
+  }
+  GraphAlgorithms::SpanningTreeResult tree =
+      GraphAlgorithms::GetMinimumSpanningTree(graph);
+  EXPECT_EQ(tree.weight, expected);
+  EXPECT_EQ(tree.edges.size(), size - 1);
+  size_t sum = 0;
+  for (const auto &edge : tree.edges) {
+    EXPECT_LT(edge.from, edge.to);
+    EXPECT_EQ(graph.GetEdge(edge.from - 1, edge.to - 1), edge.weight);
+    sum += edge.weight;
+  }
+  EXPECT_EQ(sum, expected);
+}
+
 TEST(GraphAlgorithms, GLST_1) {
   Graph graph;
   std::string file_name = "samples/graph_4_orient.adj";
@@ -437,6 +1498,86 @@ TEST(GraphAlgorithms, carlo) {
   EXPECT_LE(result.distance, 265);
 }
 
+TEST(GraphAlgorithms, SolveTravelingSalesmanProblem_memory_limit) {
+  const size_t kCities = 100000;
+  std::vector<PointSet::Point> points(kCities);
+  for (size_t i = 0; i < kCities; ++i) {
+    points[i] = {static_cast<double>(i % 1000), static_cast<double>(i / 1000)};
+  }
+  Graph implicit;
+  implicit.SetPointSet(std::make_shared<const PointSet>(
+      std::move(points), PointSet::Metric::kEuclidean));
+  EXPECT_EQ(implicit.GetRepresentation(), Graph::Representation::kImplicit);
+  GraphAlgorithms algorithm;
+  EXPECT_THROW(algorithm.SolveTravelingSalesmanProblem(implicit),
+               std::invalid_argument);
+  Graph graph;
+  graph.LoadGraphFromFile("samples/graph_11.adj");
+  graph.SetMemoryLimit(AntColonyAlgorithm::GetMemoryBytes(graph.size()) - 1);
+  EXPECT_THROW(algorithm.SolveTravelingSalesmanProblem(graph),
+               std::invalid_argument);
+  graph.SetMemoryLimit(Graph::kDefaultMemoryLimit);
+  EXPECT_EQ(algorithm.SolveTravelingSalesmanProblem(graph).vertices.size(),
+            graph.size());
+}
+
+TEST(GraphAlgorithms, implicit_VS_dense) {
+  std::vector<PointSet::Point> points = {
+      {6734, 1453}, {2233, 10},   {5530, 1424}, {401, 841},
+      {3082, 1644}, {7608, 4458}, {7573, 3716}, {7265, 1268}};
+  auto point_set = std::make_shared<const PointSet>(
+      points, PointSet::Metric::kPseudoEuclidean);
+  Graph dense;
+  Graph implicit;
+  dense.SetPointSet(point_set, Graph::Representation::kDense);
+  implicit.SetPointSet(point_set, Graph::Representation::kImplicit);
+  implicit.SetDistanceCache(1 << 10);
+  GraphAlgorithms algorithm;
+  GraphAlgorithms::TsmResult expected =
+      algorithm.DynamicProgrammingMethod(dense);
+  GraphAlgorithms::TsmResult result =
+      algorithm.DynamicProgrammingMethod(implicit);
+  EXPECT_EQ(result.vertices, expected.vertices);
+  EXPECT_EQ(result.distance, expected.distance);
+  for (auto tsm : {algorithm.SolveTravelingSalesmanProblem(implicit),
+                   algorithm.MonteCarloMethod(implicit)}) {
+    EXPECT_EQ(tsm.vertices.size(), points.size());
+    EXPECT_GE(tsm.distance, expected.distance);
+  }
+}
+
+TEST(GraphAlgorithms, implicit_VS_dense_paths) {
+  Graph dense;
+  Graph implicit;
+  dense.LoadGraphFromTsplibFile("samples/tsplib/att48.tsp",
+                                Graph::Representation::kDense);
+  implicit.LoadGraphFromTsplibFile("samples/tsplib/att48.tsp",
+                                   Graph::Representation::kImplicit);
+  EXPECT_EQ(GraphAlgorithms::BreadthFirstSearch(implicit, 5),
+            GraphAlgorithms::BreadthFirstSearch(dense, 5));
+  EXPECT_EQ(GraphAlgorithms::DepthFirstSearch(implicit, 5),
+            GraphAlgorithms::DepthFirstSearch(dense, 5));
+  using PathStrategy = GraphAlgorithms::PathStrategy;
+  for (auto strategy :
+       {PathStrategy::kDijkstra, PathStrategy::kBidirectional}) {
+    EXPECT_EQ(
+        GraphAlgorithms::GetShortestPath(implicit, 1, 48, strategy).distance,
+        GraphAlgorithms::GetShortestPath(dense, 1, 48, strategy).distance);
+  }
+  GraphAlgorithms::ResultArray vertices{1, 17, 48};
+  EXPECT_EQ(GraphAlgorithms::GetDistanceTable(implicit, vertices, vertices),
+            GraphAlgorithms::GetDistanceTable(dense, vertices, vertices));
+  LandmarkHeuristic landmarks =
+      GraphAlgorithms::BuildLandmarkHeuristic(implicit, 4);
+  EXPECT_EQ(GraphAlgorithms::GetShortestPathBetweenVertices(implicit, 3, 40,
+                                                            landmarks),
+            dense.GetEdge(2, 39));
+  ContractionHierarchy hierarchy =
+      GraphAlgorithms::BuildContractionHierarchy(implicit);
+  EXPECT_EQ(GraphAlgorithms::GetShortestPathBetweenVertices(hierarchy, 3, 40),
+            dense.GetEdge(2, 39));
+}
+
 TEST(GraphAlgorithms, dynamic) {
   Graph graph;
   std::string file_name = "samples/graph_11.adj";
@@ -449,6 +1590,431 @@ TEST(GraphAlgorithms, dynamic) {
   EXPECT_LE(result.distance, 253);
 }
 
+TEST(GraphAlgorithms, HeldKarp_brute_force) {
+  const size_t size = 9;
+  std::mt19937 generator(29);
+  std::uniform_int_distribution<size_t> weight(0, 60);
+  for (int round = 0; round < 3; ++round) {
+    // asymmetric, and some arcs missing
+    std::ofstream file("temp_random.adj");
+    file << size << std::endl;
+    for (size_t i = 0; i < size; ++i) {
+      for (size_t j = 0; j < size; ++j) {
+        file << (i == j ? 0 : weight(generator)) << " ";
+      }
+      file << std::endl;
+    }
+    file.close();
+    Graph graph;
+    graph.LoadGraphFromFile("temp_random.adj");
+    std::vector<size_t> order(size);
+    std::iota(order.begin(), order.end(), 0);
+    size_t expected = HeldKarp::kInfinity;
+    std::vector<size_t> expected_tour;
+    do {
+      size_t length = 0;
+      for (size_t i = 0; i < size && length != HeldKarp::kInfinity; ++i) {
+        size_t w = graph.GetEdge(order[i], order[(i + 1) % size]);
+        length = w == 0 ? HeldKarp::kInfinity : length + w;
+      }
+      if (length < expected) {
+        expected = length;
+        expected_tour = order;
+      }
+    } while (std::next_permutation(order.begin() + 1, order.end()));
+    for (size_t num_threads : {1, 3}) {
+      HeldKarp::Tour tour = HeldKarp::Run(graph, num_threads);
+      EXPECT_EQ(tour.distance, expected);
+      EXPECT_EQ(tour.vertices, expected_tour);
+    }
+  }
+}
+
+TEST(GraphAlgorithms, HeldKarp_no_tour) {
+  Graph graph;
+  graph.LoadGraphFromFile("samples/graph_forest.adj");
+  GraphAlgorithms algorithm;
+  GraphAlgorithms::TsmResult result = algorithm.DynamicProgrammingMethod(graph);
+  EXPECT_TRUE(result.vertices.empty());
+  EXPECT_EQ(result.distance, std::numeric_limits<double>::infinity());
+  Graph single(1);
+  result = algorithm.DynamicProgrammingMethod(single);
+  EXPECT_EQ(result.vertices, GraphAlgorithms::ResultArray({1}));
+  EXPECT_EQ(result.distance, 0);
+  Graph large(24);
+  // 23 * 2^22 32-bit costs
+  EXPECT_EQ(HeldKarp::GetTableBytes(large), size_t{23} << 24);
+  large.SetMemoryLimit(size_t{1} << 20);
+  EXPECT_THROW(HeldKarp::Run(large), std::invalid_argument);
+}
+
+TEST(GraphAlgorithms, BranchAndBound_held_karp) {
+  const size_t size = 12;
+  std::mt19937 generator(31);
+  std::uniform_int_distribution<size_t> weight(0, 80);
+  for (int round = 0; round < 6; ++round) {
+    // symmetric rounds take the 1-tree bound, the others the reduced costs
+    bool symmetric = round % 2 == 0;
+    std::vector<size_t> weights(size * size, 0);
+    for (size_t i = 0; i < size; ++i) {
+      for (size_t j = 0; j < size; ++j) {
+        if (i == j || (symmetric && j < i)) continue;
+        weights[i * size + j] = weight(generator) / (round < 4 ? 1 : 8);
+        if (symmetric) weights[j * size + i] = weights[i * size + j];
+      }
+    }
+    std::ofstream file("temp_random.adj");
+    file << size << std::endl;
+    for (size_t i = 0; i < size; ++i) {
+      for (size_t j = 0; j < size; ++j) file << weights[i * size + j] << " ";
+      file << std::endl;
+    }
+    file.close();
+    Graph graph;
+    graph.LoadGraphFromFile("temp_random.adj");
+    size_t expected = HeldKarp::Run(graph).distance;
+    for (size_t num_threads : {1, 3}) {
+      BranchAndBound search(graph);
+      BranchAndBound::Tour tour = search.Run(num_threads);
+      EXPECT_EQ(tour.distance, expected);
+      EXPECT_LE(search.GetRootBound(), expected);
+      if (expected == HeldKarp::kInfinity) {
+        EXPECT_TRUE(tour.vertices.empty());
+        continue;
+      }
+      ASSERT_EQ(tour.vertices.size(), size);
+      EXPECT_EQ(tour.vertices[0], 0);
+      size_t length = 0;
+      for (size_t i = 0; i < size; ++i) {
+        size_t w =
+            graph.GetEdge(tour.vertices[i], tour.vertices[(i + 1) % size]);
+        EXPECT_NE(w, 0);
+        length += w;
+      }
+      EXPECT_EQ(length, expected);
+      std::sort(tour.vertices.begin(), tour.vertices.end());
+      EXPECT_EQ(
+          std::adjacent_find(tour.vertices.begin(), tour.vertices.end()),
+          tour.vertices.end());
+    }
+  }
+}
+
+TEST(GraphAlgorithms, BranchAndBound_dantzig42) {
+  Graph graph;
+  graph.LoadGraphFromFile("samples/dantzig42_699.adj.txt");
+  BranchAndBound search(graph);
+  EXPECT_LE(search.GetRootBound(), 699);
+  GraphAlgorithms algorithm;
+  GraphAlgorithms::TsmResult result = algorithm.DynamicProgrammingMethod(graph);
+  EXPECT_EQ(result.distance, 699);
+  ASSERT_EQ(result.vertices.size(), 42);
+  EXPECT_EQ(result.vertices[0], 1);
+  double length = 0;
+  for (size_t i = 0; i < 42; ++i) {
+    length += graph.GetEdge(result.vertices[i] - 1,
+                            result.vertices[(i + 1) % 42] - 1);
+  }
+  EXPECT_EQ(length, 699);
+}
+
+TEST(GraphAlgorithms, BranchAndBound_memory_limit) {
+  Graph graph;
+  graph.LoadGraphFromFile("samples/dantzig42_699.adj.txt");
+  graph.SetMemoryLimit(BranchAndBound::GetMatrixBytes(graph) - 1);
+  EXPECT_THROW(BranchAndBound search(graph), std::invalid_argument);
+  GraphAlgorithms algorithm;
+  EXPECT_THROW(algorithm.DynamicProgrammingMethod(graph),
+               std::invalid_argument);
+  // too large for Held-Karp and the dense matrices alike
+  const size_t kCities = 100000;
+  std::vector<PointSet::Point> points(kCities);
+  for (size_t i = 0; i < kCities; ++i) {
+    points[i] = {static_cast<double>(i % 1000), static_cast<double>(i / 1000)};
+  }
+  Graph implicit;
+  implicit.SetPointSet(std::make_shared<const PointSet>(
+                           std::move(points), PointSet::Metric::kEuclidean),
+                       Graph::Representation::kImplicit);
+  EXPECT_THROW(algorithm.DynamicProgrammingMethod(implicit),
+               std::invalid_argument);
+}
+
+TEST(GraphAlgorithms, LocalSearch_random_tours) {
+  std::mt19937 generator(37);
+  for (bool symmetric : {true, false}) {
+    const size_t size = 60;
+    std::uniform_int_distribution<size_t> coordinate(0, 500);
+    std::vector<std::pair<size_t, size_t>> points(size);
+    for (auto &point : points) {
+      point = {coordinate(generator), coordinate(generator)};
+    }
+    std::ofstream file("temp_random.adj");
+    file << size << std::endl;
+    for (size_t i = 0; i < size; ++i) {
+      for (size_t j = 0; j < size; ++j) {
+        if (i == j) {
+          file << "0 ";
+          continue;
+        }
+        double dx = double(points[i].first) - double(points[j].first);
+        double dy = double(points[i].second) - double(points[j].second);
+        size_t extra = symmetric ? 0 : generator() % 20;
+        file << size_t(std::sqrt(dx * dx + dy * dy)) + 1 + extra << " ";
+      }
+      file << std::endl;
+    }
+    file.close();
+    Graph graph;
+    graph.LoadGraphFromFile("temp_random.adj");
+    LocalSearch search(graph);
+    std::vector<size_t> tour(size);
+    std::iota(tour.begin(), tour.end(), 0);
+    std::shuffle(tour.begin() + 1, tour.end(), generator);
+    size_t first = tour[0];
+    size_t before = search.GetLength(tour);
+    size_t after = search.Improve(tour);
+    EXPECT_EQ(after, search.GetLength(tour));
+    EXPECT_LT(after * 2, before);
+    EXPECT_EQ(tour[0], first);
+    std::vector<size_t> sorted = tour;
+    std::sort(sorted.begin(), sorted.end());
+    for (size_t i = 0; i < size; ++i) EXPECT_EQ(sorted[i], i);
+    // a second pass finds nothing left
+    EXPECT_EQ(search.Improve(tour), after);
+  }
+}
+
+TEST(GraphAlgorithms, ImproveTour_0) {
+  Graph graph;
+  graph.LoadGraphFromFile("samples/dantzig42_699.adj.txt");
+  GraphAlgorithms::TsmResult tour{{}, 0};
+  for (size_t vertex = 42; vertex >= 1; --vertex) {
+    tour.vertices.push_back(vertex);
+  }
+  std::swap(tour.vertices[5], tour.vertices[30]);
+  std::swap(tour.vertices[12], tour.vertices[21]);
+  GraphAlgorithms::TsmResult improved =
+      GraphAlgorithms::ImproveTour(graph, tour);
+  EXPECT_EQ(improved.vertices[0], 42);
+  EXPECT_GE(improved.distance, 699);
+  EXPECT_LE(improved.distance, 699 * 1.15);
+  double length = 0;
+  for (size_t i = 0; i < 42; ++i) {
+    length += graph.GetEdge(improved.vertices[i] - 1,
+                            improved.vertices[(i + 1) % 42] - 1);
+  }
+  EXPECT_EQ(length, improved.distance);
+  GraphAlgorithms::TsmResult empty{{}, 1};
+  EXPECT_EQ(GraphAlgorithms::ImproveTour(graph, empty).distance, 1);
+  tour.vertices[3] = tour.vertices[4];
+  EXPECT_THROW(GraphAlgorithms::ImproveTour(graph, tour),
+               std::invalid_argument);
+  tour.vertices.pop_back();
+  EXPECT_THROW(GraphAlgorithms::ImproveTour(graph, tour),
+               std::invalid_argument);
+}
+
+TEST(GraphAlgorithms, ImproveTour_ant_colony) {
+  Graph graph;
+  graph.LoadGraphFromFile("samples/graph_11.adj");
+  GraphAlgorithms algorithm;
+  algorithm.SetAntLocalSearch(true);
+  GraphAlgorithms::TsmResult result =
+      algorithm.SolveTravelingSalesmanProblem(graph);
+  ASSERT_EQ(result.vertices.size(), 11);
+  EXPECT_GE(result.distance, 253);
+  double length = 0;
+  for (size_t i = 0; i < 11; ++i) {
+    length += graph.GetEdge(result.vertices[i] - 1,
+                            result.vertices[(i + 1) % 11] - 1);
+  }
+  EXPECT_EQ(length, result.distance);
+}
+
+TEST(Matrix, layout) {
+  Graph::AdjacencyMatrix matrix(3, 5, 7);
+  EXPECT_EQ(matrix.GetStride(), 8);
+  for (size_t i = 0; i < matrix.GetRows(); ++i) {
+    auto address = reinterpret_cast<std::uintptr_t>(matrix[i].data());
+    EXPECT_EQ(address % Graph::AdjacencyMatrix::kAlignment, 0);
+    EXPECT_EQ(matrix[i].size(), 5);
+  }
+  matrix[1][4] = 3;
+  EXPECT_EQ(matrix(1, 4), 3);
+  EXPECT_EQ(matrix.At(1, 4), 3);
+  EXPECT_THROW(matrix.At(1, 5), std::out_of_range);
+  EXPECT_THROW(matrix.At(3, 0), std::out_of_range);
+  Graph::AdjacencyMatrix other(3, 5, 7);
+  EXPECT_NE(matrix, other);
+  other(1, 4) = 3;
+  EXPECT_EQ(matrix, other);
+}
+
+TEST(Matrix, operations) {
+  Matrix matrix = {{1, 2, 3}, {4, 5, 6}};
+  Matrix transposed = matrix.Transpose();
+  EXPECT_EQ(transposed, Matrix({{1, 4}, {2, 5}, {3, 6}}));
+  matrix.Add(matrix * 2);
+  EXPECT_EQ(matrix, Matrix({{3, 6, 9}, {12, 15, 18}}));
+  matrix.SetSize(3);
+  EXPECT_EQ(matrix, Matrix({{3, 6, 9}, {12, 15, 18}, {0, 0, 0}}));
+  EXPECT_THROW(matrix.Add(transposed), std::runtime_error);
+  EXPECT_THROW(Matrix({{1, 2}, {3}}), std::invalid_argument);
+}
+
+TEST(GraphAlgorithms, GetMinimumSpanningTree_strategies) {
+  using Strategy = GraphAlgorithms::SpanningTreeStrategy;
+  const size_t size = 2000;
+  std::mt19937 generator(17);
+  // few distinct weights, so ties have to be broken the same way
+  std::uniform_int_distribution<size_t> vertex(1, size), weight(1, 20);
+  std::ofstream file("temp_random.edges");
+  for (size_t i = 0; i < 10 * size; ++i) {
+    size_t from = vertex(generator), to = vertex(generator);
+    size_t w = weight(generator);
+    if (from == to) continue;
+    file << from << " " << to << " " << w << std::endl;
+    file << to << " " << from << " " << w << std::endl;
+  }
+  file.close();
+  Graph graph;
+  graph.LoadGraphFromFile("temp_random.edges");
+  GraphAlgorithms::SpanningTreeResult kruskal =
+      GraphAlgorithms::GetMinimumSpanningTree(graph, Strategy::kKruskal);
+  for (size_t num_threads : {1, 4}) {
+    GraphAlgorithms::SpanningTreeResult boruvka =
+        GraphAlgorithms::GetMinimumSpanningTree(graph, Strategy::kBoruvka,
+                                                num_threads);
+    EXPECT_EQ(boruvka.weight, kruskal.weight);
+    ASSERT_EQ(boruvka.edges.size(), kruskal.edges.size());
+    for (size_t i = 0; i < kruskal.edges.size(); ++i) {
+      EXPECT_EQ(boruvka.edges[i].from, kruskal.edges[i].from);
+      EXPECT_EQ(boruvka.edges[i].to, kruskal.edges[i].to);
+    }
+  }
+  GraphAlgorithms::SpanningTreeResult prim =
+      GraphAlgorithms::GetMinimumSpanningTree(graph, Strategy::kPrim);
+  EXPECT_EQ(prim.weight, kruskal.weight);
+  EXPECT_EQ(prim.edges.size(), kruskal.edges.size());
+}
+
+TEST(GraphAlgorithms, Boruvka_large_weights) {
+  // weights too wide to share a word with the edge position
+  const size_t heavy = std::numeric_limits<size_t>::max() - 1;
+  std::vector<CsrStorage::Edge> edges = {
+      {0, 1, heavy}, {1, 2, heavy - 1}, {0, 2, heavy}, {2, 3, 5},
+      {1, 3, heavy}, {3, 3, 1},         {0, 3, heavy - 1}};
+  std::vector<size_t> forest = Boruvka::Run(4, edges, 2);
+  std::sort(forest.begin(), forest.end());
+  EXPECT_EQ(forest, std::vector<size_t>({1, 3, 6}));
+}
+
+TEST(GraphAlgorithms, DynamicSpanningForest_0) {
+  Graph graph;
+  graph.LoadGraphFromFile("samples/graph_forest.adj");
+  DynamicSpanningForest forest =
+      GraphAlgorithms::BuildDynamicSpanningForest(graph);
+  EXPECT_EQ(forest.GetWeight(), 18);
+  EXPECT_EQ(forest.GetNumComponents(), 4);
+  // the same forest as GetMinimumSpanningTree, numbered alike
+  GraphAlgorithms::SpanningTreeResult tree =
+      GraphAlgorithms::GetMinimumSpanningTree(graph);
+  std::vector<CsrStorage::Edge> edges = forest.GetEdges();
+  ASSERT_EQ(edges.size(), tree.edges.size());
+  for (size_t i = 0; i < edges.size(); ++i) {
+    EXPECT_EQ(edges[i].from, tree.edges[i].from);
+    EXPECT_EQ(edges[i].to, tree.edges[i].to);
+  }
+  // joins two trees, then replaces the heaviest edge 1-2 of a cycle
+  forest.SetEdge(3, 4, 1);
+  EXPECT_EQ(forest.GetWeight(), 19);
+  forest.SetEdge(1, 4, 3);
+  EXPECT_EQ(forest.GetNumComponents(), 3);
+  EXPECT_EQ(forest.GetWeight(), 19 + 3 - 4);
+  // a lighter forest edge stays in the forest
+  forest.SetEdge(6, 7, 1);
+  EXPECT_EQ(forest.GetWeight(), 16);
+  EXPECT_EQ(forest.GetNumRebuilds(), 1);
+  edges = forest.GetEdges();
+  ASSERT_EQ(edges.size(), 5);
+  EXPECT_EQ(edges[0].from, 3);
+  EXPECT_EQ(edges[0].to, 4);
+  EXPECT_EQ(edges[0].weight, 1);
+  // removing a forest edge needs a rebuild on the next read
+  forest.RemoveEdge(1, 4);
+  forest.RemoveEdge(3, 4);
+  EXPECT_EQ(forest.GetWeight(), 2 + 4 + 9 + 1);
+  EXPECT_EQ(forest.GetNumComponents(), 4);
+  EXPECT_EQ(forest.GetNumRebuilds(), 2);
+  EXPECT_EQ(forest.GetEdge(1, 4), 0);
+  EXPECT_EQ(forest.GetEdge(3, 1), 7);
+  EXPECT_THROW(forest.SetEdge(2, 2, 5), std::invalid_argument);
+  EXPECT_THROW(forest.SetEdge(1, 9, 5), std::out_of_range);
+  EXPECT_THROW(forest.GetEdge(0, 1), std::out_of_range);
+}
+
+TEST(GraphAlgorithms, DynamicSpanningForest_random) {
+  const size_t size = 40;
+  std::mt19937 generator(23);
+  std::uniform_int_distribution<size_t> vertex(0, size - 1), weight(0, 30);
+  Graph empty(size);
+  DynamicSpanningForest forest(empty);
+  std::map<std::pair<size_t, size_t>, size_t> edges;
+  for (size_t step = 0; step < 3000; ++step) {
+    size_t from = vertex(generator), to = vertex(generator);
+    if (from == to) continue;
+    if (from > to) std::swap(from, to);
+    // inserts and decreases dominate, as in a growing network
+    size_t w = weight(generator);
+    if (w > 5 && edges.count({from, to}) && edges[{from, to}] < w &&
+        weight(generator) < 25) {
+      w = edges[{from, to}] - 1;
+    }
+    forest.SetEdge(from, to, w);
+    if (w == 0) {
+      edges.erase({from, to});
+    } else {
+      edges[{from, to}] = w;
+    }
+    if (step % 10 != 0) continue;
+    // reference: Kruskal over the edge map
+    std::vector<std::tuple<size_t, size_t, size_t>> sorted;
+    for (const auto &[ends, edge_weight] : edges) {
+      sorted.emplace_back(edge_weight, ends.first, ends.second);
+    }
+    std::sort(sorted.begin(), sorted.end());
+    DisjointSet components(size);
+    size_t expected = 0;
+    for (const auto &[edge_weight, a, b] : sorted) {
+      if (components.Unite(a, b)) expected += edge_weight;
+    }
+    ASSERT_EQ(forest.GetWeight(), expected);
+    ASSERT_EQ(forest.GetNumComponents(), components.GetNumSets());
+    ASSERT_EQ(forest.GetNumEdges(), edges.size());
+  }
+  EXPECT_LT(forest.GetNumRebuilds(), 300);
+}
+
+TEST(GraphAlgorithms, SortEdgesByWeight_0) {
+  std::mt19937_64 generator(5);
+  std::vector<CsrStorage::Edge> edges(100000);
+  for (size_t i = 0; i < edges.size(); ++i) {
+    // several digits, few distinct values, so stability is exercised
+    edges[i] = {i, i + 1, (generator() % 64) << 30};
+  }
+  std::vector<CsrStorage::Edge> expected = edges;
+  std::stable_sort(expected.begin(), expected.end(),
+                   [](const CsrStorage::Edge &a, const CsrStorage::Edge &b) {
+                     return a.weight < b.weight;
+                   });
+  SortEdgesByWeight(edges, 4);
+  for (size_t i = 0; i < edges.size(); ++i) {
+    ASSERT_EQ(edges[i].from, expected[i].from);
+    ASSERT_EQ(edges[i].weight, expected[i].weight);
+  }
+}
+
 int main(int argc, char **argv) {
   ::testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
@@ -0,0 +1,395 @@
+#include "branch_and_bound.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+#include "parallel_for.h"
+
+namespace s21 {
+
+namespace {
+
+// bounds at or above it exceed every tour
+const double kNoBound = 1e19;
+// absorbs rounding before a bound is rounded up to an integer cost
+const double kTolerance = 1e-6;
+const size_t kMaxPenaltyRounds = 1000;
+const double kMinPenaltyStep = 1e-3;
+
+}  // namespace
+
+size_t BranchAndBound::GetMatrixBytes(const Graph &graph) {
+  const size_t size = graph.size();
+  const size_t entry_bytes = sizeof(size_t) + sizeof(double) + sizeof(size_t);
+  if (size != 0 &&
+      size > std::numeric_limits<size_t>::max() / entry_bytes / size) {
+    return kInfinity;
+  }
+  return size * size * entry_bytes;
+}
+
+size_t BranchAndBound::CheckMemoryLimit(const Graph &graph) {
+  if (GetMatrixBytes(graph) > graph.GetMemoryLimit()) {
+    throw std::invalid_argument(
+        "The branch and bound matrices exceed the memory limit.");
+  }
+  return graph.size();
+}
+
+BranchAndBound::BranchAndBound(const Graph &graph)
+    : size_(CheckMemoryLimit(graph)),
+      cost_(size_ * size_, kInfinity),
+      penalised_(size_ * size_),
+      penalty_(size_, 0.0),
+      best_{{}, kInfinity},
+      upper_bound_(kInfinity) {
+  size_t max_weight = 0;
+  for (size_t i = 0; i < size_; ++i) {
+    for (size_t j = 0; j < size_; ++j) {
+      size_t weight = i == j ? 0 : graph.GetEdge(i, j);
+      if (weight != 0) cost_[i * size_ + j] = weight;
+      max_weight = std::max(max_weight, weight);
+    }
+  }
+  const double missing = 4.0 * static_cast<double>(max_weight) * size_ + 1;
+  for (size_t i = 0; i < size_ * size_; ++i) {
+    penalised_[i] =
+        cost_[i] == kInfinity ? missing : static_cast<double>(cost_[i]);
+  }
+  for (size_t i = 0; i < size_ && symmetric_; ++i) {
+    for (size_t j = 0; j < i; ++j) {
+      if (GetCost(i, j) != GetCost(j, i)) symmetric_ = false;
+    }
+  }
+  SortNeighbours();
+  FindNearestNeighbourTour();
+  if (symmetric_ && size_ > 2) TunePenalties();
+}
+
+BranchAndBound::Tour BranchAndBound::Run(size_t num_threads) {
+  if (size_ < 2) return {std::vector<size_t>(size_, 0), 0};
+  num_threads = GetNumThreads(num_threads);
+  std::vector<Task> tasks =
+      Split(num_threads == 1 ? 1 : num_threads * kTasksPerThread);
+  std::atomic<size_t> num_nodes(0);
+  ParallelFor(0, tasks.size(), num_threads, [&](size_t index) {
+    const Task &task = tasks[index];
+    if (task.bound >= upper_bound_.load(std::memory_order_relaxed)) return;
+    State state(size_);
+    for (size_t depth = 0; depth < task.path.size(); ++depth) {
+      state.path[depth] = task.path[depth];
+      state.FlipVisited(task.path[depth]);
+    }
+    Search(state, task.path.size(), task.path.back(), task.length);
+    num_nodes += state.num_nodes;
+  });
+  num_nodes_ = num_nodes;
+  return best_;
+}
+
+std::vector<BranchAndBound::Task> BranchAndBound::Split(size_t num_tasks) {
+  // Expands the open paths level by level; closed paths and those that
+  // cannot beat the upper bound are dropped.
+  State state(size_);
+  state.FlipVisited(0);
+  root_bound_ = std::max(root_bound_, GetLowerBound(state, 1, 0, 0));
+  std::vector<Task> tasks{{{0}, 0, root_bound_}};
+  for (size_t depth = 1; depth + 1 < size_ && tasks.size() < num_tasks;
+       ++depth) {
+    std::vector<Task> children;
+    for (const Task &task : tasks) {
+      std::fill(state.visited.begin(), state.visited.end(), 0);
+      for (size_t vertex : task.path) state.FlipVisited(vertex);
+      size_t current = task.path.back();
+      const size_t *neighbour = &neighbours_[current * (size_ - 1)];
+      for (size_t i = 0; i < num_neighbours_[current]; ++i) {
+        size_t next = neighbour[i];
+        if (state.IsVisited(next)) continue;
+        size_t length = task.length + GetCost(current, next);
+        if (length >= upper_bound_) break;
+        state.FlipVisited(next);
+        size_t bound = GetLowerBound(state, depth + 1, next, length);
+        state.FlipVisited(next);
+        if (bound >= upper_bound_) continue;
+        children.push_back({task.path, length, bound});
+        children.back().path.push_back(next);
+      }
+    }
+    tasks.swap(children);
+  }
+  std::stable_sort(
+      tasks.begin(), tasks.end(),
+      [](const Task &a, const Task &b) { return a.bound < b.bound; });
+  return tasks;
+}
+
+void BranchAndBound::SortNeighbours() {
+  if (size_ == 0) return;
+  neighbours_.resize(size_ * (size_ - 1));
+  num_neighbours_.assign(size_, 0);
+  for (size_t from = 0; from < size_; ++from) {
+    size_t *neighbour = &neighbours_[from * (size_ - 1)];
+    size_t count = 0;
+    for (size_t to = 0; to < size_; ++to) {
+      if (GetCost(from, to) != kInfinity) neighbour[count++] = to;
+    }
+    std::sort(neighbour, neighbour + count, [&](size_t a, size_t b) {
+      return GetCost(from, a) < GetCost(from, b) ||
+             (GetCost(from, a) == GetCost(from, b) && a < b);
+    });
+    num_neighbours_[from] = count;
+  }
+}
+
+void BranchAndBound::FindNearestNeighbourTour() {
+  if (size_ < 2) return;
+  State state(size_);
+  state.FlipVisited(0);
+  size_t current = 0;
+  size_t length = 0;
+  for (size_t depth = 1; depth < size_; ++depth) {
+    const size_t *neighbour = &neighbours_[current * (size_ - 1)];
+    size_t i = 0;
+    while (i < num_neighbours_[current] && state.IsVisited(neighbour[i])) {
+      ++i;
+    }
+    if (i == num_neighbours_[current]) return;
+    length += GetCost(current, neighbour[i]);
+    current = neighbour[i];
+    state.path[depth] = current;
+    state.FlipVisited(current);
+  }
+  if (GetCost(current, 0) != kInfinity) {
+    Improve(state.path, length + GetCost(current, 0));
+  }
+}
+
+void BranchAndBound::TunePenalties() {
+  std::vector<double> penalty(size_, 0.0);
+  std::vector<int> degree(size_);
+  State state(size_);
+  double best_bound = -kNoBound;
+  double step_scale = 2.0;
+  size_t num_stalled = 0;
+  for (size_t round = 0;
+       round < kMaxPenaltyRounds && step_scale > kMinPenaltyStep; ++round) {
+    double bound = GetOneTreeBound(penalty, degree, state);
+    if (bound > best_bound + kTolerance) {
+      best_bound = bound;
+      penalty_ = penalty;
+      num_stalled = 0;
+    } else if (++num_stalled == size_) {
+      step_scale /= 2;
+      num_stalled = 0;
+    }
+    double norm = 0;
+    for (int d : degree) norm += (d - 2) * (d - 2);
+    // the 1-tree is a tour, or no tour can beat the best one
+    if (norm == 0 || best_bound > static_cast<double>(best_.distance) - 1 +
+                                      kTolerance) {
+      break;
+    }
+    double target = best_.distance != kInfinity
+                        ? static_cast<double>(best_.distance)
+                        : bound + std::abs(bound) / 20 + 1;
+    double step = step_scale * (target - bound) / norm;
+    for (size_t i = 0; i < size_; ++i) penalty[i] += step * (degree[i] - 2);
+  }
+  for (size_t i = 0; i < size_; ++i) {
+    for (size_t j = 0; j < size_; ++j) {
+      penalised_[i * size_ + j] += penalty_[i] + penalty_[j];
+    }
+  }
+  if (best_bound > 0) {
+    root_bound_ = static_cast<size_t>(std::ceil(best_bound - kTolerance));
+  }
+}
+
+double BranchAndBound::GetOneTreeBound(const std::vector<double> &penalty,
+                                       std::vector<int> &degree,
+                                       State &state) {
+  auto cost = [&](size_t from, size_t to) {
+    return GetPenalisedCost(from, to) + penalty[from] + penalty[to];
+  };
+  // Prim on vertices 1..size_ - 1, state.rest holds the parents
+  std::fill(degree.begin(), degree.end(), 0);
+  std::vector<char> in_tree(size_, 0);
+  in_tree[1] = 1;
+  for (size_t v = 2; v < size_; ++v) {
+    state.key[v] = cost(1, v);
+    state.rest[v] = 1;
+  }
+  double total = 0;
+  for (size_t added = 2; added < size_; ++added) {
+    size_t next = 0;
+    for (size_t v = 2; v < size_; ++v) {
+      if (!in_tree[v] && (next == 0 || state.key[v] < state.key[next])) {
+        next = v;
+      }
+    }
+    in_tree[next] = 1;
+    total += state.key[next];
+    ++degree[next];
+    ++degree[state.rest[next]];
+    for (size_t v = 2; v < size_; ++v) {
+      if (!in_tree[v] && cost(next, v) < state.key[v]) {
+        state.key[v] = cost(next, v);
+        state.rest[v] = next;
+      }
+    }
+  }
+  // the two cheapest edges of vertex 0
+  size_t first = 1;
+  size_t second = 2;
+  if (cost(0, second) < cost(0, first)) std::swap(first, second);
+  for (size_t v = 3; v < size_; ++v) {
+    if (cost(0, v) < cost(0, first)) {
+      second = first;
+      first = v;
+    } else if (cost(0, v) < cost(0, second)) {
+      second = v;
+    }
+  }
+  total += cost(0, first) + cost(0, second);
+  degree[0] = 2;
+  ++degree[first];
+  ++degree[second];
+  for (double p : penalty) total -= 2 * p;
+  return total;
+}
+
+size_t BranchAndBound::GetLowerBound(State &state, size_t depth,
+                                     size_t current, size_t length) const {
+  if (depth + 1 == size_) {
+    size_t last = 0;
+    while (state.IsVisited(last)) ++last;
+    if (GetCost(current, last) == kInfinity || GetCost(last, 0) == kInfinity) {
+      return kInfinity;
+    }
+    return length + GetCost(current, last) + GetCost(last, 0);
+  }
+  double rest = symmetric_ ? GetOneTreeRest(state, current)
+                           : GetReducedRest(state, current);
+  double bound = static_cast<double>(length) + rest;
+  if (!(bound < kNoBound)) return kInfinity;
+  return std::max(length,
+                  static_cast<size_t>(std::ceil(bound - kTolerance)));
+}
+
+double BranchAndBound::GetOneTreeRest(State &state, size_t current) const {
+  // A path from current through the unvisited vertices U back to 0 is a
+  // spanning tree of U and one edge at each end. Under penalties it costs
+  // its own length plus twice the penalties of U and those of both ends.
+  size_t count = 0;
+  double penalties = penalty_[current] + penalty_[0];
+  double enter = kNoBound;
+  double leave = kNoBound;
+  for (size_t v = 0; v < size_; ++v) {
+    if (state.IsVisited(v)) continue;
+    state.rest[count++] = v;
+    penalties += 2 * penalty_[v];
+    enter = std::min(enter, GetPenalisedCost(current, v));
+    leave = std::min(leave, GetPenalisedCost(v, 0));
+  }
+  // Prim, the vertices still outside the tree in state.rest[1, end)
+  double tree = 0;
+  for (size_t i = 1; i < count; ++i) {
+    state.key[i] = GetPenalisedCost(state.rest[0], state.rest[i]);
+  }
+  for (size_t end = count; end > 1; --end) {
+    size_t next = 1;
+    for (size_t i = 2; i < end; ++i) {
+      if (state.key[i] < state.key[next]) next = i;
+    }
+    tree += state.key[next];
+    size_t added = state.rest[next];
+    std::swap(state.rest[next], state.rest[end - 1]);
+    std::swap(state.key[next], state.key[end - 1]);
+    for (size_t i = 1; i + 1 < end; ++i) {
+      state.key[i] =
+          std::min(state.key[i], GetPenalisedCost(added, state.rest[i]));
+    }
+  }
+  return std::max(0.0, tree + enter + leave - penalties);
+}
+
+double BranchAndBound::GetReducedRest(State &state, size_t current) const {
+  // The rest of the tour leaves current and every unvisited vertex once and
+  // enters every unvisited vertex and 0 once: an assignment between those
+  // sources and targets. Subtracting the row minima and then the column
+  // minima of the reduced matrix, or the other way round, bounds it.
+  size_t count = 0;
+  for (size_t v = 0; v < size_; ++v) {
+    if (!state.IsVisited(v)) state.rest[count++] = v;
+  }
+  // source s is current for 0 and state.rest[s - 1] otherwise, target t is
+  // state.rest[t] below count and 0 for count
+  auto cost = [&](size_t s, size_t t) {
+    if (s == 0 && t == count) return kInfinity;
+    if (s != 0 && s - 1 == t) return kInfinity;
+    return GetCost(s == 0 ? current : state.rest[s - 1],
+                   t == count ? 0 : state.rest[t]);
+  };
+  double bound = 0;
+  for (bool rows_first : {true, false}) {
+    double total = 0;
+    for (size_t i = 0; i <= count; ++i) {
+      size_t least = kInfinity;
+      for (size_t j = 0; j <= count; ++j) {
+        least = std::min(least, rows_first ? cost(i, j) : cost(j, i));
+      }
+      if (least == kInfinity) return kNoBound;
+      state.key[i] = static_cast<double>(least);
+      total += state.key[i];
+    }
+    for (size_t j = 0; j <= count; ++j) {
+      double least = kNoBound;
+      for (size_t i = 0; i <= count; ++i) {
+        size_t weight = rows_first ? cost(i, j) : cost(j, i);
+        if (weight != kInfinity) {
+          least = std::min(least, static_cast<double>(weight) - state.key[i]);
+        }
+      }
+      total += least;
+    }
+    bound = std::max(bound, total);
+  }
+  return bound;
+}
+
+void BranchAndBound::Search(State &state, size_t depth, size_t current,
+                            size_t length) {
+  ++state.num_nodes;
+  if (depth == size_) {
+    size_t closing = GetCost(current, 0);
+    if (closing != kInfinity) Improve(state.path, length + closing);
+    return;
+  }
+  if (GetLowerBound(state, depth, current, length) >=
+      upper_bound_.load(std::memory_order_relaxed)) {
+    return;
+  }
+  const size_t *neighbour = &neighbours_[current * (size_ - 1)];
+  for (size_t i = 0; i < num_neighbours_[current]; ++i) {
+    size_t next = neighbour[i];
+    if (state.IsVisited(next)) continue;
+    size_t next_length = length + GetCost(current, next);
+    // the remaining neighbours cost no less
+    if (next_length >= upper_bound_.load(std::memory_order_relaxed)) break;
+    state.FlipVisited(next);
+    state.path[depth] = next;
+    Search(state, depth + 1, next, next_length);
+    state.FlipVisited(next);
+  }
+}
+
+void BranchAndBound::Improve(const std::vector<size_t> &path,
+                             size_t distance) {
+  std::lock_guard<std::mutex> lock(best_mutex_);
+  if (distance >= best_.distance) return;
+  best_ = {path, distance};
+  upper_bound_.store(distance, std::memory_order_relaxed);
+}
+
+}  // namespace s21
@@ -0,0 +1,130 @@
+#ifndef NAVIGATOR_TSP_BRANCH_AND_BOUND_H_
+#define NAVIGATOR_TSP_BRANCH_AND_BOUND_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <mutex>
+#include <vector>
+
+#include "s21_graph.h"
+
+namespace s21 {
+
+/** BranchAndBound
+ *! @brief Exact travelling salesman tours by depth-first branch and bound
+ *! from vertex 0. The path grows and shrinks in place, the visited set is a
+ *! bitset, and neighbours are tried from the cheapest one, so the first
+ *! expensive neighbour ends the loop. A nearest neighbour tour is the
+ *! initial upper bound. Every partial path is bounded by a 1-tree on the
+ *! rest of the vertices when the graph is symmetric, with Held-Karp
+ *! penalties tuned once by subgradient optimisation, and by the reduced
+ *! cost matrix of the remaining arcs otherwise. Threads search subtrees
+ *! handed out one at a time and prune against one shared upper bound.
+ *! Internal vertex numbering.
+ */
+class BranchAndBound {
+ public:
+  static constexpr size_t kInfinity = std::numeric_limits<size_t>::max();
+
+  // the tour starts at vertex 0 and does not repeat it; no vertices and
+  // kInfinity if the graph has no Hamiltonian cycle
+  struct Tour {
+    std::vector<size_t> vertices;
+    size_t distance;
+  };
+
+  // cost, penalised cost and neighbour matrices of the graph
+  static size_t GetMatrixBytes(const Graph &graph);
+
+  // Throws std::invalid_argument if the matrices exceed the graph memory
+  // limit.
+  explicit BranchAndBound(const Graph &graph);
+
+  // A shortest tour; num_threads 0 uses every hardware thread.
+  Tour Run(size_t num_threads = 0);
+  // search tree nodes visited by the last Run
+  size_t GetNumNodes() const { return num_nodes_; }
+  // bound on every tour before branching
+  size_t GetRootBound() const { return root_bound_; }
+
+ private:
+  // subtrees per thread; more balance the load better
+  static const size_t kTasksPerThread = 64;
+
+  // graph.size() once the matrices fit the memory limit
+  static size_t CheckMemoryLimit(const Graph &graph);
+
+  // scratch of one search, allocated once per subtree
+  struct State {
+    explicit State(size_t size)
+        : path(size, 0), visited((size + 63) / 64, 0), rest(size), key(size) {}
+    bool IsVisited(size_t vertex) const {
+      return (visited[vertex / 64] >> (vertex % 64)) & 1;
+    }
+    void FlipVisited(size_t vertex) {
+      visited[vertex / 64] ^= uint64_t{1} << (vertex % 64);
+    }
+
+    std::vector<size_t> path;
+    std::vector<uint64_t> visited;
+    std::vector<size_t> rest;
+    std::vector<double> key;
+    size_t num_nodes = 0;
+  };
+  // the first depth vertices of a path and their length
+  struct Task {
+    std::vector<size_t> path;
+    size_t length;
+    size_t bound;
+  };
+
+  void SortNeighbours();
+  void FindNearestNeighbourTour();
+  // Held-Karp penalties maximising the 1-tree bound
+  void TunePenalties();
+  // 1-tree of all vertices under penalties, returns its bound and fills
+  // degree
+  double GetOneTreeBound(const std::vector<double> &penalty,
+                         std::vector<int> &degree, State &state);
+  // open paths, at least num_tasks unless the tree is smaller, by bound
+  std::vector<Task> Split(size_t num_tasks);
+  // lower bound on tours extending the path of depth vertices ending at
+  // current
+  size_t GetLowerBound(State &state, size_t depth, size_t current,
+                       size_t length) const;
+  double GetOneTreeRest(State &state, size_t current) const;
+  double GetReducedRest(State &state, size_t current) const;
+  void Search(State &state, size_t depth, size_t current, size_t length);
+  void Improve(const std::vector<size_t> &path, size_t distance);
+
+  size_t GetCost(size_t from, size_t to) const {
+    return cost_[from * size_ + to];
+  }
+  double GetPenalisedCost(size_t from, size_t to) const {
+    return penalised_[from * size_ + to];
+  }
+
+  size_t size_;
+  bool symmetric_ = true;
+  // kInfinity where there is no edge
+  std::vector<size_t> cost_;
+  // cost plus both penalties; missing edges cost more than any tour
+  std::vector<double> penalised_;
+  std::vector<double> penalty_;
+  // size_ - 1 other vertices per vertex from the cheapest one, vertices
+  // without an edge left out
+  std::vector<size_t> neighbours_;
+  std::vector<size_t> num_neighbours_;
+  Tour best_;
+  // best_.distance, read by every thread without the lock
+  std::atomic<size_t> upper_bound_;
+  std::mutex best_mutex_;
+  size_t num_nodes_ = 0;
+  size_t root_bound_ = 0;
+};
+
+}  // namespace s21
+
+#endif  // NAVIGATOR_TSP_BRANCH_AND_BOUND_H_
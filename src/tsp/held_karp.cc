@@ -0,0 +1,165 @@
+#include "held_karp.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+
+#include "parallel_for.h"
+
+namespace s21 {
+
+namespace {
+
+// calls function(mask) for every mask below 1 << bits with count bits set,
+// in increasing order (Gosper's hack)
+template <typename Function>
+void ForEachSubset(size_t bits, size_t count, Function function) {
+  if (count > bits) return;
+  if (count == 0) {
+    function(uint64_t{0});
+    return;
+  }
+  const uint64_t end = uint64_t{1} << bits;
+  for (uint64_t mask = (uint64_t{1} << count) - 1; mask < end;) {
+    function(mask);
+    uint64_t ripple = mask + (mask & (~mask + 1));
+    mask = ripple | (((ripple ^ mask) >> 2) >> __builtin_ctzll(mask));
+  }
+}
+
+// Entries of all sets below set, where a set has one entry per member:
+// below the highest bit b of set lie 2^b sets sharing the bits above b.
+inline uint64_t GetOffset(uint64_t set) {
+  uint64_t offset = 0;
+  uint64_t above = 0;
+  while (set != 0) {
+    size_t b = 63 - __builtin_clzll(set);
+    offset += above << b;
+    if (b > 0) offset += uint64_t{b} << (b - 1);
+    ++above;
+    set ^= uint64_t{1} << b;
+  }
+  return offset;
+}
+
+}  // namespace
+
+size_t HeldKarp::GetTableBytes(const Graph &graph) {
+  size_t size = graph.size();
+  if (size > kMaxVertices) return kInfinity;
+  if (size < 2) return 0;
+  size_t cost_bytes = HasNarrowCosts(graph) ? 4 : 8;
+  return (size - 1) * (size_t{1} << (size - 2)) * cost_bytes;
+}
+
+HeldKarp::Tour HeldKarp::Run(const Graph &graph, size_t num_threads) {
+  size_t size = graph.size();
+  if (size < 2) return {std::vector<size_t>(size, 0), 0};
+  if (GetTableBytes(graph) > graph.GetMemoryLimit()) {
+    throw std::invalid_argument(
+        "The Held-Karp table exceeds the memory limit.");
+  }
+  return HasNarrowCosts(graph) ? Solve<uint32_t>(graph, num_threads)
+                               : Solve<uint64_t>(graph, num_threads);
+}
+
+bool HeldKarp::HasNarrowCosts(const Graph &graph) {
+  size_t size = graph.size();
+  size_t max_weight = 0;
+  for (size_t i = 0; i < size; ++i) {
+    for (size_t j = 0; j < size; ++j) {
+      max_weight = std::max(max_weight, graph.GetEdge(i, j));
+    }
+  }
+  // every partial path stays below the 32-bit infinity
+  return max_weight < std::numeric_limits<uint32_t>::max() / size;
+}
+
+template <typename Cost>
+HeldKarp::Tour HeldKarp::Solve(const Graph &graph, size_t num_threads) {
+  constexpr Cost kNoPath = std::numeric_limits<Cost>::max();
+  const size_t size = graph.size();
+  // DP vertex j is vertex j + 1, sets are masks over DP vertices
+  const size_t num_others = size - 1;
+  std::vector<Cost> cost(size * size);
+  for (size_t i = 0; i < size; ++i) {
+    for (size_t j = 0; j < size; ++j) {
+      size_t weight = graph.GetEdge(i, j);
+      cost[i * size + j] = weight == 0 ? kNoPath : static_cast<Cost>(weight);
+    }
+  }
+  // The row of set U holds, for each member j in increasing order, the
+  // shortest path from j through the rest of U to vertex 0. Rows are
+  // ordered by set, so a row is read contiguously.
+  std::vector<Cost> path(num_others << (num_others - 1));
+  for (size_t j = 0; j < num_others; ++j) {
+    path[GetOffset(uint64_t{1} << j)] = cost[(j + 1) * size];
+  }
+  auto fill_row = [&](uint64_t set) {
+    Cost *entry = &path[GetOffset(set)];
+    for (uint64_t members = set; members != 0; members &= members - 1) {
+      size_t j = __builtin_ctzll(members);
+      uint64_t rest = set ^ (uint64_t{1} << j);
+      const Cost *tail = &path[GetOffset(rest)];
+      const Cost *step = &cost[(j + 1) * size + 1];
+      Cost best = kNoPath;
+      for (; rest != 0; rest &= rest - 1, ++tail) {
+        size_t k = __builtin_ctzll(rest);
+        if (step[k] != kNoPath && *tail != kNoPath) {
+          best = std::min<Cost>(best, step[k] + *tail);
+        }
+      }
+      *entry++ = best;
+    }
+  };
+  // Layer s holds the sets of s vertices. One task per pair of highest
+  // bits, the largest groups first, balances the threads.
+  std::vector<std::pair<size_t, size_t>> tasks;
+  for (size_t s = 2; s <= num_others; ++s) {
+    tasks.clear();
+    for (size_t top = num_others; top-- > s - 1;) {
+      for (size_t second = top; second-- > s - 2;) {
+        tasks.push_back({top, second});
+      }
+    }
+    ParallelFor(0, tasks.size(), num_threads, [&](size_t task) {
+      auto [top, second] = tasks[task];
+      uint64_t high = (uint64_t{1} << top) | (uint64_t{1} << second);
+      ForEachSubset(second, s - 2,
+                    [&](uint64_t lower) { fill_row(high | lower); });
+    });
+  }
+  const uint64_t all = (uint64_t{1} << num_others) - 1;
+  Cost best = kNoPath;
+  const Cost *tail = &path[GetOffset(all)];
+  for (uint64_t rest = all; rest != 0; rest &= rest - 1, ++tail) {
+    Cost step = cost[__builtin_ctzll(rest) + 1];
+    if (step != kNoPath && *tail != kNoPath) {
+      best = std::min<Cost>(best, step + *tail);
+    }
+  }
+  if (best == kNoPath) return {{}, kInfinity};
+  // the smallest next vertex that still completes a shortest tour
+  Tour tour{{0}, best};
+  size_t from = 0;
+  uint64_t left = all;
+  Cost remaining = best;
+  while (left != 0) {
+    tail = &path[GetOffset(left)];
+    for (uint64_t rest = left; rest != 0; rest &= rest - 1, ++tail) {
+      size_t k = __builtin_ctzll(rest);
+      Cost step = cost[from * size + k + 1];
+      if (step != kNoPath && *tail != kNoPath && step + *tail == remaining) {
+        tour.vertices.push_back(k + 1);
+        from = k + 1;
+        left ^= uint64_t{1} << k;
+        remaining = *tail;
+        break;
+      }
+    }
+  }
+  return tour;
+}
+
+}  // namespace s21
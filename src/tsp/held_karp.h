@@ -0,0 +1,49 @@
+#ifndef NAVIGATOR_TSP_HELD_KARP_H_
+#define NAVIGATOR_TSP_HELD_KARP_H_
+
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+#include "s21_graph.h"
+
+namespace s21 {
+
+/** HeldKarp
+ *! @brief Exact travelling salesman tours by Held-Karp dynamic programming
+ *! in O(2^n * n^2) time. For every set U of vertices other than 0 and
+ *! member j the flat table holds the shortest path from j through the
+ *! rest of U to vertex 0, one row of members per set; sets of one size
+ *! form a layer computed in parallel from the previous one. Costs are
+ *! 32-bit when every tour fits: 800 MB for 25 vertices. Internal vertex
+ *! numbering.
+ */
+class HeldKarp {
+ public:
+  static constexpr size_t kInfinity = std::numeric_limits<size_t>::max();
+  // the largest graph whose table size is representable
+  static const size_t kMaxVertices = 40;
+
+  // the tour starts at vertex 0 and does not repeat it; no vertices and
+  // kInfinity if the graph has no Hamiltonian cycle
+  struct Tour {
+    std::vector<size_t> vertices;
+    size_t distance;
+  };
+
+  // kInfinity above kMaxVertices
+  static size_t GetTableBytes(const Graph &graph);
+  // Lexicographically smallest of the shortest tours. Throws
+  // std::invalid_argument if the table exceeds the graph memory limit;
+  // num_threads 0 uses every hardware thread.
+  static Tour Run(const Graph &graph, size_t num_threads = 0);
+
+ private:
+  static bool HasNarrowCosts(const Graph &graph);
+  template <typename Cost>
+  static Tour Solve(const Graph &graph, size_t num_threads);
+};
+
+}  // namespace s21
+
+#endif  // NAVIGATOR_TSP_HELD_KARP_H_
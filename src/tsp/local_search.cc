@@ -0,0 +1,187 @@
+#include "local_search.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace s21 {
+
+LocalSearch::LocalSearch(const Graph &graph, size_t num_candidates)
+    : graph_(graph),
+      symmetric_(graph.GraphOrientationCheck()),
+      num_candidates_(num_candidates),
+      candidates_(graph.size() * num_candidates, kInfinity) {
+  size_t max_weight = 0;
+  std::vector<std::pair<size_t, size_t>> row;
+  for (size_t from = 0; from < graph.size(); ++from) {
+    row.clear();
+    graph.ForEachNeighbour(from, [&](const Graph::Neighbour &neighbour) {
+      if (neighbour.vertex == from) return;
+      row.push_back({neighbour.weight, neighbour.vertex});
+      max_weight = std::max(max_weight, neighbour.weight);
+    });
+    size_t count = std::min(row.size(), num_candidates_);
+    std::partial_sort(row.begin(), row.begin() + count, row.end());
+    for (size_t i = 0; i < count; ++i) {
+      candidates_[from * num_candidates_ + i] = row[i].second;
+    }
+  }
+  missing_cost_ = static_cast<int64_t>(max_weight + 1) *
+                  static_cast<int64_t>(std::max<size_t>(graph.size(), 1));
+}
+
+size_t LocalSearch::Improve(std::vector<size_t> &tour) {
+  const size_t size = tour.size();
+  if (size < 3) return GetLength(tour);
+  const size_t first = tour[0];
+  order_ = tour;
+  position_.assign(graph_.size(), 0);
+  for (size_t i = 0; i < size; ++i) position_[order_[i]] = i;
+  // Don't-look bits can miss a move that an earlier move elsewhere made
+  // possible, so rounds with every vertex active repeat until one finds
+  // nothing.
+  for (bool improved = true; improved;) {
+    improved = false;
+    active_.assign(order_.begin(), order_.end());
+    is_active_.assign(graph_.size(), 1);
+    while (!active_.empty()) {
+      size_t vertex = active_.front();
+      active_.pop_front();
+      is_active_[vertex] = 0;
+      // an improved vertex stays active until nothing is left to gain
+      if ((symmetric_ && TryTwoOpt(vertex)) || TryOrOpt(vertex)) {
+        Activate(vertex);
+        improved = true;
+      }
+    }
+  }
+  std::rotate(order_.begin(), order_.begin() + position_[first],
+              order_.end());
+  tour = order_;
+  return GetLength(tour);
+}
+
+size_t LocalSearch::GetLength(const std::vector<size_t> &tour) const {
+  size_t length = 0;
+  for (size_t i = 0; i < tour.size(); ++i) {
+    size_t weight = graph_.GetEdge(tour[i], tour[(i + 1) % tour.size()]);
+    if (weight == 0 && tour.size() > 1) return kInfinity;
+    length += weight;
+  }
+  return length;
+}
+
+void LocalSearch::Activate(size_t vertex) {
+  if (is_active_[vertex]) return;
+  is_active_[vertex] = 1;
+  active_.push_back(vertex);
+}
+
+bool LocalSearch::TryTwoOpt(size_t a) {
+  // Replaces the tour edges a-b and c-d by a-c and b-d, with b and d on
+  // the same side of a and c; a-c must be shorter than a-b to gain.
+  for (bool forward : {true, false}) {
+    size_t b = forward ? GetNext(a) : GetPrevious(a);
+    int64_t ab = GetCost(a, b);
+    const size_t *candidate = GetCandidates(a);
+    for (size_t i = 0; i < num_candidates_ && candidate[i] != kInfinity;
+         ++i) {
+      size_t c = candidate[i];
+      int64_t ac = GetCost(a, c);
+      if (ac >= ab) break;
+      size_t d = forward ? GetNext(c) : GetPrevious(c);
+      if (c == b || d == a) continue;
+      if (ac + GetCost(b, d) - ab - GetCost(c, d) >= 0) continue;
+      if (forward) {
+        Reverse(b, c);
+      } else {
+        Reverse(a, d);
+      }
+      for (size_t vertex : {a, b, c, d}) Activate(vertex);
+      return true;
+    }
+  }
+  return false;
+}
+
+bool LocalSearch::TryOrOpt(size_t first) {
+  // Moves the segment first..last between c and d, the ends of some edge
+  // next to a candidate of either end of the segment.
+  const size_t size = order_.size();
+  size_t last = first;
+  for (size_t length = 1; length <= kMaxSegment && length + 2 <= size;
+       ++length, last = GetNext(last)) {
+    size_t previous = GetPrevious(first);
+    size_t next = GetNext(last);
+    int64_t removed = GetCost(previous, first) + GetCost(last, next) -
+                      GetCost(previous, next);
+    if (removed <= 0) continue;
+    auto in_segment = [&](size_t vertex) {
+      return (position_[vertex] + size - position_[first]) % size < length;
+    };
+    for (size_t end : {first, last}) {
+      const size_t *candidate = GetCandidates(end);
+      for (size_t i = 0; i < num_candidates_ && candidate[i] != kInfinity;
+           ++i) {
+        size_t x = candidate[i];
+        if (GetCost(end, x) >= removed) break;
+        if (in_segment(x)) continue;
+        for (auto [c, d] : {std::pair(x, GetNext(x)),
+                            std::pair(GetPrevious(x), x)}) {
+          if (in_segment(c) || in_segment(d)) continue;
+          int64_t kept = GetCost(c, d);
+          bool reversed = false;
+          int64_t added = GetCost(c, first) + GetCost(last, d) - kept;
+          if (symmetric_) {
+            int64_t flipped = GetCost(c, last) + GetCost(first, d) - kept;
+            if (flipped < added) {
+              added = flipped;
+              reversed = true;
+            }
+          }
+          if (added >= removed) continue;
+          MoveSegment(first, length, c, reversed);
+          for (size_t vertex : {previous, next, first, last, c, d}) {
+            Activate(vertex);
+          }
+          return true;
+        }
+      }
+    }
+  }
+  return false;
+}
+
+void LocalSearch::Reverse(size_t first, size_t last) {
+  const size_t size = order_.size();
+  size_t i = position_[first];
+  size_t j = position_[last];
+  size_t length = (j + size - i) % size + 1;
+  // the rest of the tour reversed gives the same cycle
+  if (2 * length > size) {
+    std::swap(i, j);
+    i = (i + 1) % size;
+    j = (j + size - 1) % size;
+    length = size - length;
+  }
+  for (size_t k = 0; k < length / 2; ++k) {
+    std::swap(order_[i], order_[j]);
+    position_[order_[i]] = i;
+    position_[order_[j]] = j;
+    i = (i + 1) % size;
+    j = (j + size - 1) % size;
+  }
+}
+
+void LocalSearch::MoveSegment(size_t first, size_t length, size_t after,
+                              bool reversed) {
+  const size_t size = order_.size();
+  size_t offset = (position_[after] + size - position_[first]) % size;
+  std::rotate(order_.begin(), order_.begin() + position_[first],
+              order_.end());
+  auto segment_end = order_.begin() + offset + 1;
+  std::rotate(order_.begin(), order_.begin() + length, segment_end);
+  if (reversed) std::reverse(segment_end - length, segment_end);
+  for (size_t i = 0; i < size; ++i) position_[order_[i]] = i;
+}
+
+}  // namespace s21
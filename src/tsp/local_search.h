@@ -0,0 +1,78 @@
+#ifndef NAVIGATOR_TSP_LOCAL_SEARCH_H_
+#define NAVIGATOR_TSP_LOCAL_SEARCH_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <limits>
+#include <vector>
+
+#include "s21_graph.h"
+
+namespace s21 {
+
+/** LocalSearch
+ *! @brief Improves travelling salesman tours with 2-opt and Or-opt moves
+ *! until none shortens them. Moves only join a vertex to one of its
+ *! nearest neighbours from a candidate list, and a don't-look bit keeps
+ *! vertices whose surroundings have not changed from being tried again.
+ *! 2-opt reverses part of the tour and Or-opt may move a segment reversed,
+ *! so both are used on symmetric graphs only; asymmetric graphs get Or-opt
+ *! in the tour direction. Internal vertex numbering.
+ */
+class LocalSearch {
+ public:
+  static constexpr size_t kInfinity = std::numeric_limits<size_t>::max();
+  static const size_t kDefaultNumCandidates = 8;
+  // longest segment Or-opt moves
+  static const size_t kMaxSegment = 3;
+
+  explicit LocalSearch(const Graph &graph,
+                       size_t num_candidates = kDefaultNumCandidates);
+
+  // Improves tour, an order of all vertices, in place and keeps its first
+  // vertex. Missing edges count as longer than any tour, so they are
+  // replaced where possible. Returns the new length.
+  size_t Improve(std::vector<size_t> &tour);
+  // kInfinity if the tour uses a missing edge
+  size_t GetLength(const std::vector<size_t> &tour) const;
+
+ private:
+  int64_t GetCost(size_t from, size_t to) const {
+    size_t weight = graph_.GetEdge(from, to);
+    return weight == 0 ? missing_cost_ : static_cast<int64_t>(weight);
+  }
+  size_t GetNext(size_t vertex) const {
+    return order_[(position_[vertex] + 1) % order_.size()];
+  }
+  size_t GetPrevious(size_t vertex) const {
+    return order_[(position_[vertex] + order_.size() - 1) % order_.size()];
+  }
+  const size_t *GetCandidates(size_t vertex) const {
+    return &candidates_[vertex * num_candidates_];
+  }
+  void Activate(size_t vertex);
+  bool TryTwoOpt(size_t vertex);
+  bool TryOrOpt(size_t vertex);
+  // reverses the tour from vertex first forwards to vertex last
+  void Reverse(size_t first, size_t last);
+  // puts length vertices from first between after and its successor
+  void MoveSegment(size_t first, size_t length, size_t after, bool reversed);
+
+  const Graph &graph_;
+  bool symmetric_;
+  size_t num_candidates_;
+  // num_candidates_ nearest neighbours per vertex, kInfinity padded
+  std::vector<size_t> candidates_;
+  int64_t missing_cost_;
+  // the tour being improved and where each vertex is in it
+  std::vector<size_t> order_;
+  std::vector<size_t> position_;
+  // vertices whose don't-look bit is clear
+  std::deque<size_t> active_;
+  std::vector<char> is_active_;
+};
+
+}  // namespace s21
+
+#endif  // NAVIGATOR_TSP_LOCAL_SEARCH_H_